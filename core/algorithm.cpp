@@ -1,20 +1,41 @@
 #include "algorithm.h"
+#include "algorithm_texts.h"
+#include "allocation_tracker.h"
+#include "benchmark_trace.h"
+#include "cache_control.h"
+#include "data_structure_builder.h"
+#include "execution_environment.h"
 #include "property_editor_factory.h"
 
 #include <QComboBox>
 #include <QLabel>
 #include <QLayout>
 #include <QMetaProperty>
+#include <QThread>
 #include <QWidget>
 
+#include <utility>
+
 Algorithm::Algorithm(QObject* parent)
     : QObject(parent)
     , iterationsNumber(1000)
+    , warmupRunsNumber(0)
+    , repetitionsNumber(1)
+    , trackAllocations(false)
+    , recordTrace(false)
+    , pinnedCore(-1)
+    , raisePriority(false)
+    , detectThrottling(false)
+    , threadScaling(false)
+    , maxThreadsNumber(QThread::idealThreadCount())
+    , checkpointInterval(0)
+    , iterationTimeBudget(0)
 #ifdef QT_DEBUG
     , isDebugRun(false)
 #endif
-    , requestedEnd(false)
     , currentIteration(0)
+    , threadsNumber(1)
+    , selectedCacheMode(CacheModes::AfterBuild)
 {
     setAutoDelete(false);
 }
@@ -29,6 +50,53 @@ bool Algorithm::canRunAlgorithm(QString &outInfo) const
     return true;
 }
 
+bool Algorithm::canRunBenchmark(QString &outInfo) const
+{
+    const ComplexityExpression complexity = getSelectedComplexity();
+    if(!complexity.isValid())
+    {
+        outInfo = AlgorithmTexts::InvalidComplexityExpression + complexity.getErrorString();
+        return false;
+    }
+
+    if(trackAllocations && !AllocationTracker::isAvailable())
+    {
+        outInfo = AlgorithmTexts::AllocationTrackerNotAvailable;
+        return false;
+    }
+
+    if(selectedCacheMode == CacheModes::OtherCore && CacheControl::getAvailableCores().size() < 2)
+    {
+        outInfo = AlgorithmTexts::OtherCoreNotAvailable;
+        return false;
+    }
+
+    if(pinnedCore >= 0 && !CacheControl::getAvailableCores().contains(pinnedCore))
+    {
+        outInfo = AlgorithmTexts::PinnedCoreNotAvailable;
+        return false;
+    }
+
+    if(threadScaling && !isParallel())
+    {
+        outInfo = AlgorithmTexts::NotParallelAlgorithm;
+        return false;
+    }
+
+    if(threadScaling && maxThreadsNumber < 1)
+    {
+        outInfo = AlgorithmTexts::InvalidMaxThreadsNumber;
+        return false;
+    }
+
+    return canRunAlgorithm(outInfo);
+}
+
+bool Algorithm::isParallel() const
+{
+    return false;
+}
+
 QWidget *Algorithm::createPropertiesWidget(QWidget* parent)
 {
     QStringList complexityStringList;
@@ -42,7 +110,16 @@ QWidget *Algorithm::createPropertiesWidget(QWidget* parent)
     PropertyEditorFactory& propertyEditorFactory = PropertyEditorFactory::get();
 
     QWidget* propertiesWidget = propertyEditorFactory.createPropertiesWidget(this, parent);
-    propertyEditorFactory.addStringListComboBox(propertiesWidget, complexityStringList, "complexity", selectedComplexity);
+    QComboBox* complexityComboBox = propertyEditorFactory.addStringListComboBox(propertiesWidget, complexityStringList, "complexity", selectedComplexity, true);
+    complexityComboBox->setToolTip(AlgorithmTexts::ComplexityExpressionHelp);
+
+    QComboBox* cacheModeComboBox = propertyEditorFactory.addStringListComboBox(propertiesWidget, CacheModes::All, "cache mode", selectedCacheMode);
+    cacheModeComboBox->setToolTip(AlgorithmTexts::CacheModeHelp);
+
+    if(QWidget* trackAllocationsWidget = propertiesWidget->findChild<QWidget*>("trackAllocations"))
+    {
+        trackAllocationsWidget->setToolTip(AlgorithmTexts::TrackAllocationsHelp);
+    }
 
     return propertiesWidget;
 }
@@ -69,11 +146,387 @@ void Algorithm::appendPropertiesInfo(QString &infoText)
 
     infoText.append("complexity : " + selectedComplexity);
     infoText.append("\n");
+
+    infoText.append("cache mode : " + selectedCacheMode);
+    infoText.append("\n");
+}
+
+DataStructureBuilder *Algorithm::getSelectedBuilder() const
+{
+    for(DataStructureBuilder* builder : dataStructureBuilders)
+    {
+        if(builder->objectName() == selectedBuilderName)
+        {
+            return builder;
+        }
+    }
+
+    return dataStructureBuilders.isEmpty() ? nullptr : dataStructureBuilders.first();
+}
+
+QStringList Algorithm::getBuilderNames() const
+{
+    QStringList builderNames;
+    builderNames.reserve(dataStructureBuilders.size());
+
+    for(const DataStructureBuilder* builder : dataStructureBuilders)
+    {
+        builderNames.append(builder->objectName());
+    }
+
+    return builderNames;
+}
+
+bool Algorithm::selectBuilder(const QString &builderName)
+{
+    if(!getBuilderNames().contains(builderName))
+    {
+        return false;
+    }
+
+    selectedBuilderName = builderName;
+    return true;
+}
+
+bool Algorithm::selectCacheMode(const QString &cacheMode)
+{
+    if(!CacheModes::All.contains(cacheMode))
+    {
+        return false;
+    }
+
+    selectedCacheMode = cacheMode;
+    return true;
+}
+
+void Algorithm::selectComplexity(const QString &complexity)
+{
+    selectedComplexity = complexity;
+}
+
+const QString &Algorithm::getSelectedComplexityName() const
+{
+    return selectedComplexity;
+}
+
+const QString &Algorithm::getSelectedCacheMode() const
+{
+    return selectedCacheMode;
+}
+
+QList<BenchmarkPartialResults> Algorithm::takePartialResults()
+{
+    return partialResultsQueue.takeAll();
+}
+
+void Algorithm::publishPartialResults(BenchmarkPartialResults &pendingResults, int completedIterations, bool force)
+{
+    if(!partialResultsTimer.isValid())
+    {
+        partialResultsTimer.start();
+    }
+
+    if(pendingResults.isEmpty())
+    {
+        return;
+    }
+
+    if(!force && pendingResults.points.size() < PartialResultsBatchSize && partialResultsTimer.elapsed() < PartialResultsIntervalMs)
+    {
+        return;
+    }
+
+    pendingResults.completedIterations = completedIterations;
+    pendingResults.iterationsNumber = iterationsNumber;
+
+    partialResultsQueue.push(std::move(pendingResults));
+    pendingResults = BenchmarkPartialResults();
+
+    partialResultsTimer.restart();
+}
+
+void Algorithm::startTrace()
+{
+    if(recordTrace)
+    {
+        TraceRecorder::getThreadRecorder().start();
+    }
+}
+
+void Algorithm::finishTrace(QString &infoText)
+{
+    TraceRecorder& traceRecorder = TraceRecorder::getThreadRecorder();
+    if(!traceRecorder.isRecording())
+    {
+        return;
+    }
+
+    traceRecorder.stop();
+
+    const quint64 droppedEventsNum = traceRecorder.getDroppedEventsNum();
+
+    QString outInfo;
+    if(TraceFile::appendEvents(traceRecorder.takeEvents(), outInfo))
+    {
+        infoText.append("trace : " + TraceFile::DefaultFilePath);
+        if(droppedEventsNum > 0)
+        {
+            infoText.append(" (oldest " + QString::number(droppedEventsNum) + " events dropped)");
+        }
+        if(!outInfo.isEmpty())
+        {
+            infoText.append(", " + outInfo);
+        }
+    }
+    else
+    {
+        infoText.append("trace : " + outInfo);
+    }
+
+    infoText.append("\n");
+}
+
+void Algorithm::setUpExecutionEnvironment(ThreadAffinityGuard &affinityGuard, ThreadPriorityGuard &priorityGuard, BenchmarkRunInfo &runInfo, QString &infoText)
+{
+    if(pinnedCore >= 0)
+    {
+        affinityGuard.moveTo(pinnedCore);
+    }
+
+    if(raisePriority && !priorityGuard.raise())
+    {
+        infoText.append("priority : could not be raised");
+        infoText.append("\n");
+    }
+
+    // queried after pinning, so the frequencies are the ones of the measuring core
+    const CpuInfo cpuInfo = CpuInfo::query();
+    runInfo.environment = cpuInfo.toJsonObject();
+
+    infoText.append("cpu : " + cpuInfo.getDescription());
+    infoText.append("\n");
+
+    if(cpuInfo.isFrequencyCapped())
+    {
+        infoText.append(AlgorithmTexts::FrequencyCapped);
+        infoText.append("\n");
+    }
+}
+
+BenchmarkCheckpoint Algorithm::captureCheckpointSettings() const
+{
+    BenchmarkCheckpoint checkpoint;
+    checkpoint.algorithmName = objectName();
+
+    BenchmarkRunInfo& runInfo = checkpoint.results.emplace_back().runInfo;
+    runInfo.algorithmName = objectName();
+    runInfo.algorithmProperties = BenchmarkRunInfo::propertiesToJsonObject(this);
+    runInfo.algorithmProperties["complexity"] = selectedComplexity;
+    runInfo.algorithmProperties["cacheMode"] = selectedCacheMode;
+
+    if(const DataStructureBuilder* builder = getSelectedBuilder())
+    {
+        runInfo.builderName = builder->objectName();
+        runInfo.builderProperties = BenchmarkRunInfo::propertiesToJsonObject(builder);
+    }
+
+    return checkpoint;
+}
+
+bool Algorithm::restoreCheckpointSettings(const BenchmarkCheckpoint &checkpoint, QString &outInfo)
+{
+    const BenchmarkRunInfo& runInfo = checkpoint.results.first().runInfo;
+
+    QJsonObject algorithmProperties = runInfo.algorithmProperties;
+    if(!selectCacheMode(algorithmProperties.take("cacheMode").toString()))
+    {
+        outInfo = AlgorithmTexts::UnknownJobCacheMode + runInfo.algorithmProperties["cacheMode"].toString();
+        return false;
+    }
+
+    selectComplexity(algorithmProperties.take("complexity").toString());
+
+    if(!selectBuilder(runInfo.builderName))
+    {
+        outInfo = AlgorithmTexts::UnknownJobBuilder + runInfo.builderName;
+        return false;
+    }
+
+    restoreProperties(this, algorithmProperties);
+    restoreProperties(getSelectedBuilder(), runInfo.builderProperties);
+
+    return true;
+}
+
+void Algorithm::addComplexity(const QString &name, const QString &expressionText)
+{
+    const ComplexityExpression expression(expressionText);
+    Q_ASSERT_X(expression.isValid(), "Algorithm::addComplexity", qPrintable(expression.getErrorString()));
+
+    complexityList.push_back(qMakePair(name, expression));
+}
+
+ComplexityExpression Algorithm::getSelectedComplexity() const
+{
+    auto it = std::find_if(complexityList.begin(), complexityList.end(), [&](const ComplexityNameToExpression& pair)
+    {
+        return pair.first == selectedComplexity;
+    });
+
+    if(it != complexityList.end())
+    {
+        return it->second;
+    }
+
+    // accept both "E*log2(V)" and "O(E*log2(V))"
+    QString expressionText = selectedComplexity.trimmed();
+    if(expressionText.startsWith("O(") && expressionText.endsWith(")"))
+    {
+        expressionText = expressionText.mid(2, expressionText.size() - 3);
+    }
+
+    return ComplexityExpression(expressionText);
+}
+
+void Algorithm::appendCountersInfo(const AlgorithmBenchmarkResult &resultData, QString &infoText) const
+{
+    QStringList counterNames;
+    for(auto it = resultData.subSeriesNameToSubSeriesData.constBegin(); it != resultData.subSeriesNameToSubSeriesData.constEnd(); ++it)
+    {
+        if(it.value().isCounter)
+        {
+            counterNames.append(it.key());
+        }
+    }
+
+    counterNames.sort();
+
+    for(const QString& counterName : std::as_const(counterNames))
+    {
+        QList<QPointF> points = resultData.subSeriesNameToSubSeriesData.value(counterName).points;
+        points.removeIf([](const QPointF& point)
+        {
+            return point.x() <= 0.0;
+        });
+
+        if(points.isEmpty())
+        {
+            continue;
+        }
+
+        const qreal firstRatio = points.first().y() / points.first().x();
+        const qreal lastRatio = points.last().y() / points.last().x();
+
+        infoText.append(counterName + " / complexity : " + QString::number(firstRatio, 'g', 4) + " -> " + QString::number(lastRatio, 'g', 4));
+        infoText.append("\n");
+    }
+}
+
+void Algorithm::analyzeComplexity(AlgorithmBenchmarkResult &resultData) const
+{
+    ComplexityAnalysis& complexityAnalysis = resultData.complexityAnalysis;
+    complexityAnalysis = ComplexityAnalysis();
+
+    const QList<ComplexityVariables>& inputs = resultData.mainSeriesInputs;
+    if(inputs.size() != resultData.mainSeries.size())
+    {
+        return;
+    }
+
+    QList<qreal> times;
+    QList<qreal> nodes;
+    QList<qreal> edges;
+
+    times.reserve(inputs.size());
+    nodes.reserve(inputs.size());
+    edges.reserve(inputs.size());
+
+    for(int i = 0; i < inputs.size(); ++i)
+    {
+        times.append(resultData.mainSeries[i].y());
+        nodes.append(inputs[i].nodesNum);
+        edges.append(inputs[i].edgesNum);
+    }
+
+    ComplexityPairsList candidates = complexityList;
+
+    const bool isCustomComplexity = std::none_of(complexityList.begin(), complexityList.end(), [&](const ComplexityNameToExpression& pair)
+    {
+        return pair.first == selectedComplexity;
+    });
+
+    if(isCustomComplexity && currentComplexity.isValid())
+    {
+        candidates.push_back(qMakePair(selectedComplexity, currentComplexity));
+    }
+
+    QList<qreal> modelValues(inputs.size());
+    for(const auto& complexity : candidates)
+    {
+        for(int i = 0; i < inputs.size(); ++i)
+        {
+            modelValues[i] = complexity.second.evaluate(inputs[i]);
+        }
+
+        complexityAnalysis.rankedFits.append(ComplexityFit::fit(complexity.first, modelValues, times));
+    }
+
+    complexityAnalysis.rank();
+
+    complexityAnalysis.nodesExponent = EmpiricalExponent::estimate(nodes, times);
+    complexityAnalysis.edgesExponent = EmpiricalExponent::estimate(edges, times);
 }
 
 void Algorithm::requestEnd()
 {
-    requestedEnd = true;
+    cancellationToken.cancel();
+}
+
+void Algorithm::restoreProperties(QObject *object, const QJsonObject &properties)
+{
+    for(auto it = properties.constBegin(); it != properties.constEnd(); ++it)
+    {
+        const QByteArray propertyName = it.key().toUtf8();
+        if(object->metaObject()->indexOfProperty(propertyName.constData()) >= 0)
+        {
+            object->setProperty(propertyName.constData(), it.value().toVariant());
+        }
+    }
+}
+
+bool Algorithm::prepareResume(QString &outInfo)
+{
+    BenchmarkCheckpoint checkpoint;
+    if(!checkpoint.load(BenchmarkCheckpoint::getFilePath(objectName()), outInfo))
+    {
+        return false;
+    }
+
+    // restoreCheckpointSettings changes the algorithm and the builder of the checkpoint, a resume that cannot run puts both back
+    const BenchmarkCheckpoint previousSettings = captureCheckpointSettings();
+
+    QList<QJsonObject> previousBuildersProperties;
+    previousBuildersProperties.reserve(dataStructureBuilders.size());
+    for(const DataStructureBuilder* builder : std::as_const(dataStructureBuilders))
+    {
+        previousBuildersProperties.append(BenchmarkRunInfo::propertiesToJsonObject(builder));
+    }
+
+    if(!restoreCheckpointSettings(checkpoint, outInfo) || !canRunBenchmark(outInfo))
+    {
+        QString restoreInfo;
+        restoreCheckpointSettings(previousSettings, restoreInfo);
+
+        for(int i = 0; i < dataStructureBuilders.size(); ++i)
+        {
+            restoreProperties(dataStructureBuilders[i], previousBuildersProperties[i]);
+        }
+
+        return false;
+    }
+
+    resumeCheckpoint = std::move(checkpoint);
+    return true;
 }
 
 int Algorithm::getIterationsNumber() const
@@ -92,6 +545,182 @@ void Algorithm::setIterationsNumber(int newIterationsNumber)
     emit iterationsNumberChanged();
 }
 
+int Algorithm::getWarmupRunsNumber() const
+{
+    return warmupRunsNumber;
+}
+
+void Algorithm::setWarmupRunsNumber(int newWarmupRunsNumber)
+{
+    if (warmupRunsNumber == newWarmupRunsNumber)
+    {
+        return;
+    }
+
+    warmupRunsNumber = newWarmupRunsNumber;
+    emit warmupRunsNumberChanged();
+}
+
+int Algorithm::getRepetitionsNumber() const
+{
+    return repetitionsNumber;
+}
+
+void Algorithm::setRepetitionsNumber(int newRepetitionsNumber)
+{
+    if (repetitionsNumber == newRepetitionsNumber)
+    {
+        return;
+    }
+
+    repetitionsNumber = newRepetitionsNumber;
+    emit repetitionsNumberChanged();
+}
+
+bool Algorithm::getTrackAllocations() const
+{
+    return trackAllocations;
+}
+
+void Algorithm::setTrackAllocations(bool newTrackAllocations)
+{
+    if (trackAllocations == newTrackAllocations)
+    {
+        return;
+    }
+
+    trackAllocations = newTrackAllocations;
+    emit trackAllocationsChanged();
+}
+
+bool Algorithm::getRecordTrace() const
+{
+    return recordTrace;
+}
+
+void Algorithm::setRecordTrace(bool newRecordTrace)
+{
+    if (recordTrace == newRecordTrace)
+    {
+        return;
+    }
+
+    recordTrace = newRecordTrace;
+    emit recordTraceChanged();
+}
+
+int Algorithm::getPinnedCore() const
+{
+    return pinnedCore;
+}
+
+void Algorithm::setPinnedCore(int newPinnedCore)
+{
+    if (pinnedCore == newPinnedCore)
+    {
+        return;
+    }
+
+    pinnedCore = newPinnedCore;
+    emit pinnedCoreChanged();
+}
+
+bool Algorithm::getRaisePriority() const
+{
+    return raisePriority;
+}
+
+void Algorithm::setRaisePriority(bool newRaisePriority)
+{
+    if (raisePriority == newRaisePriority)
+    {
+        return;
+    }
+
+    raisePriority = newRaisePriority;
+    emit raisePriorityChanged();
+}
+
+bool Algorithm::getDetectThrottling() const
+{
+    return detectThrottling;
+}
+
+void Algorithm::setDetectThrottling(bool newDetectThrottling)
+{
+    if (detectThrottling == newDetectThrottling)
+    {
+        return;
+    }
+
+    detectThrottling = newDetectThrottling;
+    emit detectThrottlingChanged();
+}
+
+bool Algorithm::getThreadScaling() const
+{
+    return threadScaling;
+}
+
+void Algorithm::setThreadScaling(bool newThreadScaling)
+{
+    if (threadScaling == newThreadScaling)
+    {
+        return;
+    }
+
+    threadScaling = newThreadScaling;
+    emit threadScalingChanged();
+}
+
+int Algorithm::getMaxThreadsNumber() const
+{
+    return maxThreadsNumber;
+}
+
+void Algorithm::setMaxThreadsNumber(int newMaxThreadsNumber)
+{
+    if (maxThreadsNumber == newMaxThreadsNumber)
+    {
+        return;
+    }
+
+    maxThreadsNumber = newMaxThreadsNumber;
+    emit maxThreadsNumberChanged();
+}
+
+int Algorithm::getCheckpointInterval() const
+{
+    return checkpointInterval;
+}
+
+void Algorithm::setCheckpointInterval(int newCheckpointInterval)
+{
+    if (checkpointInterval == newCheckpointInterval)
+    {
+        return;
+    }
+
+    checkpointInterval = newCheckpointInterval;
+    emit checkpointIntervalChanged();
+}
+
+int Algorithm::getIterationTimeBudget() const
+{
+    return iterationTimeBudget;
+}
+
+void Algorithm::setIterationTimeBudget(int newIterationTimeBudget)
+{
+    if (iterationTimeBudget == newIterationTimeBudget)
+    {
+        return;
+    }
+
+    iterationTimeBudget = newIterationTimeBudget;
+    emit iterationTimeBudgetChanged();
+}
+
 #ifdef QT_DEBUG
 bool Algorithm::getIsDebugRun() const
 {
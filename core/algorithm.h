@@ -1,10 +1,15 @@
 #ifndef ALGORITHM_H
 #define ALGORITHM_H
 
+#include "../core/benchmark_cancellation.h"
+#include "../core/benchmark_checkpoint.h"
+#include "../core/benchmark_partial_results.h"
 #include "../core/benchmark_timers.h"
+#include "../core/complexity_expression.h"
 
 #include <functional>
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <QRunnable>
 #include <QPointF>
@@ -13,16 +18,32 @@
 
 class DataStructureBuilder;
 class DataStructure;
+class ThreadAffinityGuard;
+class ThreadPriorityGuard;
 
 class Algorithm : public QObject, public QRunnable
 {
     Q_OBJECT
 
     Q_PROPERTY(int iterationsNumber READ getIterationsNumber WRITE setIterationsNumber NOTIFY iterationsNumberChanged FINAL)
+    Q_PROPERTY(int warmupRunsNumber READ getWarmupRunsNumber WRITE setWarmupRunsNumber NOTIFY warmupRunsNumberChanged FINAL)
+    Q_PROPERTY(int repetitionsNumber READ getRepetitionsNumber WRITE setRepetitionsNumber NOTIFY repetitionsNumberChanged FINAL)
+    Q_PROPERTY(bool trackAllocations READ getTrackAllocations WRITE setTrackAllocations NOTIFY trackAllocationsChanged FINAL)
+    Q_PROPERTY(bool recordTrace READ getRecordTrace WRITE setRecordTrace NOTIFY recordTraceChanged FINAL)
+    Q_PROPERTY(int pinnedCore READ getPinnedCore WRITE setPinnedCore NOTIFY pinnedCoreChanged FINAL)
+    Q_PROPERTY(bool raisePriority READ getRaisePriority WRITE setRaisePriority NOTIFY raisePriorityChanged FINAL)
+    Q_PROPERTY(bool detectThrottling READ getDetectThrottling WRITE setDetectThrottling NOTIFY detectThrottlingChanged FINAL)
+    Q_PROPERTY(bool threadScaling READ getThreadScaling WRITE setThreadScaling NOTIFY threadScalingChanged FINAL)
+    Q_PROPERTY(int maxThreadsNumber READ getMaxThreadsNumber WRITE setMaxThreadsNumber NOTIFY maxThreadsNumberChanged FINAL)
+    Q_PROPERTY(int checkpointInterval READ getCheckpointInterval WRITE setCheckpointInterval NOTIFY checkpointIntervalChanged FINAL)
+    Q_PROPERTY(int iterationTimeBudget READ getIterationTimeBudget WRITE setIterationTimeBudget NOTIFY iterationTimeBudgetChanged FINAL)
 public:
-    using ComplexityFunction = std::function<qreal(int, int, int)>;
-    using ComplexityNameToFunction = QPair<QString, ComplexityFunction>;
-    using ComplexityPairsList = QList<ComplexityNameToFunction>;
+    using ComplexityNameToExpression = QPair<QString, ComplexityExpression>;
+    using ComplexityPairsList = QList<ComplexityNameToExpression>;
+
+    // the window polls takePartialResults at the same interval
+    static constexpr int PartialResultsBatchSize = 16;
+    static constexpr int PartialResultsIntervalMs = 250;
 
     explicit Algorithm(QObject* parent = nullptr);
     virtual ~Algorithm() = 0;
@@ -32,18 +53,73 @@ public:
 
     virtual bool canRunAlgorithm(QString& outInfo) const;
 
+    virtual bool canRunBenchmark(QString& outInfo) const;
+
+    virtual bool isParallel() const;
+
     virtual QWidget* createPropertiesWidget(QWidget* parent = nullptr);
     virtual void appendPropertiesInfo(QString& infoText);
 
+    DataStructureBuilder* getSelectedBuilder() const;
+    QStringList getBuilderNames() const;
+
+    // false when there is no builder or cache mode of that name
+    bool selectBuilder(const QString& builderName);
+    bool selectCacheMode(const QString& cacheMode);
+
+    void selectComplexity(const QString& complexity);
+
+    const QString& getSelectedComplexityName() const;
+    const QString& getSelectedCacheMode() const;
+
 #ifdef QT_DEBUG
     virtual void debugRun() {};
 #endif
 
+    // safe to call from any thread, a running kernel that polls the cancellation token returns within a few of its steps
     void requestEnd();
 
+    bool prepareResume(QString& outInfo);
+
+    // points finished since the last call, safe to call from the GUI thread while the benchmark runs
+    QList<BenchmarkPartialResults> takePartialResults();
+
     int getIterationsNumber() const;
     void setIterationsNumber(int newIterationsNumber);
 
+    int getWarmupRunsNumber() const;
+    void setWarmupRunsNumber(int newWarmupRunsNumber);
+
+    int getRepetitionsNumber() const;
+    void setRepetitionsNumber(int newRepetitionsNumber);
+
+    bool getTrackAllocations() const;
+    void setTrackAllocations(bool newTrackAllocations);
+
+    bool getRecordTrace() const;
+    void setRecordTrace(bool newRecordTrace);
+
+    int getPinnedCore() const;
+    void setPinnedCore(int newPinnedCore);
+
+    bool getRaisePriority() const;
+    void setRaisePriority(bool newRaisePriority);
+
+    bool getDetectThrottling() const;
+    void setDetectThrottling(bool newDetectThrottling);
+
+    bool getThreadScaling() const;
+    void setThreadScaling(bool newThreadScaling);
+
+    int getMaxThreadsNumber() const;
+    void setMaxThreadsNumber(int newMaxThreadsNumber);
+
+    int getCheckpointInterval() const;
+    void setCheckpointInterval(int newCheckpointInterval);
+
+    int getIterationTimeBudget() const;
+    void setIterationTimeBudget(int newIterationTimeBudget);
+
 #ifdef QT_DEBUG
     bool getIsDebugRun() const;
     void setIsDebugRun(bool newIsDebugRun);
@@ -54,25 +130,87 @@ signals:
     void finished(const AlgorithmBenchmarkResult &resultData);
 
     void iterationsNumberChanged();
+    void warmupRunsNumberChanged();
+    void repetitionsNumberChanged();
+    void trackAllocationsChanged();
+    void recordTraceChanged();
+    void pinnedCoreChanged();
+    void raisePriorityChanged();
+    void detectThrottlingChanged();
+    void threadScalingChanged();
+    void maxThreadsNumberChanged();
+    void checkpointIntervalChanged();
+    void iterationTimeBudgetChanged();
 
 protected:
     virtual void execute() = 0;
 
+    void publishPartialResults(BenchmarkPartialResults& pendingResults, int completedIterations, bool force = false);
+
+    void startTrace();
+
+    void finishTrace(QString& infoText);
+
+    void addComplexity(const QString& name, const QString& expressionText);
+
+    ComplexityExpression getSelectedComplexity() const;
+
+    void analyzeComplexity(AlgorithmBenchmarkResult& resultData) const;
+
+    /**
+     * For every counter sub-series the operations per unit of the selected complexity at the first and the last point.
+     * A counter that grows exactly like the complexity keeps the same ratio.
+     */
+    void appendCountersInfo(const AlgorithmBenchmarkResult& resultData, QString& infoText) const;
+
+    /**
+     * Pins the calling thread to pinnedCore and raises its priority when asked to, the guards restore both when they go out of scope.
+     * Describes the processor the benchmark runs on in infoText, with a warning when its clock is scaled.
+     */
+    void setUpExecutionEnvironment(ThreadAffinityGuard& affinityGuard, ThreadPriorityGuard& priorityGuard, BenchmarkRunInfo& runInfo, QString& infoText);
+
+    virtual bool restoreCheckpointSettings(const BenchmarkCheckpoint& checkpoint, QString& outInfo);
+
+    virtual BenchmarkCheckpoint captureCheckpointSettings() const;
+
+    static void restoreProperties(QObject* object, const QJsonObject& properties);
+
     int iterationsNumber;
+    int warmupRunsNumber;
+    int repetitionsNumber;
+    bool trackAllocations;
+    bool recordTrace;
+    int pinnedCore; // -1 lets the system schedule the benchmark on any core
+    bool raisePriority;
+    bool detectThrottling;
+    bool threadScaling; // runs 1..maxThreadsNumber threads instead of the usual sweep over input sizes
+    int maxThreadsNumber;
+    int checkpointInterval; // seconds between checkpoints of a running sweep, 0 saves one only when the sweep is paused
+    int iterationTimeBudget; // milliseconds the measured runs of one representation in a sweep iteration may take before it is truncated, 0 means no budget
     QString selectedComplexity;
 
 #ifdef QT_DEBUG
     bool isDebugRun;
 #endif
 
-    bool requestedEnd;
+    BenchmarkCancellationToken cancellationToken;
 
     ComplexityPairsList complexityList;
 
     QList<DataStructureBuilder*> dataStructureBuilders;
+    QString selectedBuilderName; // empty selects the first builder
 
-    ComplexityFunction currentComplexityFunction;
+    ComplexityExpression currentComplexity;
     int currentIteration;
+
+    int threadsNumber;
+
+    QString selectedCacheMode;
+
+    BenchmarkCheckpoint resumeCheckpoint;
+
+    BenchmarkPartialResultsQueue partialResultsQueue;
+    QElapsedTimer partialResultsTimer;
 };
 
 #endif // ALGORITHM_H
@@ -6,6 +6,34 @@
 namespace AlgorithmTexts
 {
     inline const QString NoAlgorithmSelected = "No algorithm selected.";
+    inline const QString InvalidComplexityExpression = "Complexity expression is invalid: ";
+    inline const QString NoSeriesToCompare = "Run or load a benchmark first, the last series is compared with the baseline.";
+    inline const QString AllocationTrackerNotAvailable = "Allocation tracking is not compiled in, configure the project with ALGORITHMS_ALLOCATION_TRACKER=ON.";
+    inline const QString OtherCoreNotAvailable = "The other core cache mode needs at least two logical processors available to the application.";
+    inline const QString PinnedCoreNotAvailable = "The pinned core is not available to the application, pick one of the logical processors or -1.";
+    inline const QString FrequencyCapped = "warning : the frequency is capped below the base frequency, cycles of separate runs may not be comparable";
+    inline const QString NotParallelAlgorithm = "Thread scaling needs an algorithm that splits its work over threads.";
+    inline const QString InvalidMaxThreadsNumber = "Thread scaling needs a max threads number of at least 1.";
+    inline const QString BenchmarkRunning = "A benchmark is running, wait for it or pause it first.";
+    inline const QString SuiteRunning = "A benchmark suite is running, stop it first.";
+    inline const QString NoBenchmarkJobs = "There are no benchmark jobs to run.";
+    inline const QString UnknownSchedule = "Unknown benchmark schedule: ";
+    inline const QString NoWorkerCores = "The parallel schedule needs at least one worker core, the first logical processor is kept for the window.";
+    inline const QString UnknownJobBuilder = "The algorithm has no builder named ";
+    inline const QString UnknownJobProperty = "There is no property named ";
+    inline const QString UnknownJobCacheMode = "Unknown cache mode: ";
+    inline const QString JobStopped = "stopped before it finished";
+    inline const QString NoCheckpoints = "There are no checkpoints in the working directory, a sweep leaves one when it is paused or when it has a checkpoint interval.";
+    inline const QString NoAlgorithmForCheckpoint = "No algorithm of the window is named ";
+    inline const QString CacheModeHelp = "after build: the measured run follows building the graph or the previous run.\n"
+                                         "warm: every measured run follows an unmeasured run on the same graph.\n"
+                                         "cold: caches are evicted before every measured run.\n"
+                                         "other core: the graph is touched on one core, the measured run happens on another.";
+    inline const QString TrackAllocationsHelp = "Counts only allocations made with operator new and new[].\n"
+                                                "Qt containers such as QList, QQueue, QStack and QHash allocate their buffers with malloc, those are not counted.";
+    inline const QString ComplexityExpressionHelp = "Pick a complexity or type an expression, e.g. E*log2(V)/8.\n"
+                                                    "Variables: I (iteration), V, E, Wmin, Wmax.\n"
+                                                    "Functions: log, log2, log10, sqrt, exp, abs, min, max, pow.";
 }
 
 
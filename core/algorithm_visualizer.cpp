@@ -1,16 +1,25 @@
 #include "algorithm_visualizer.h"
 
+#include "benchmark_trace.h"
 #include "property_editor_factory.h"
 
+#include <QDebug>
 #include <QMetaProperty>
 #include <QVBoxLayout>
 
 AlgorithmVisualizer::AlgorithmVisualizer(QObject *parent)
     : QObject(parent)
     , stepTime(1000)
+    , recordTrace(false)
 {
     visualizationTimer.setInterval(stepTime);
-    connect(&visualizationTimer, &QTimer::timeout, this, &AlgorithmVisualizer::updateVisualization);
+    connect(&visualizationTimer, &QTimer::timeout, this, [this]()
+    {
+        TraceScope traceScope("update visualization", "visualizer");
+        updateVisualization();
+    });
+
+    connect(this, &AlgorithmVisualizer::finished, this, &AlgorithmVisualizer::finishTrace);
 }
 
 AlgorithmVisualizer::~AlgorithmVisualizer()
@@ -18,6 +27,17 @@ AlgorithmVisualizer::~AlgorithmVisualizer()
 
 }
 
+void AlgorithmVisualizer::start(QWidget *widget)
+{
+    if(recordTrace)
+    {
+        TraceRecorder::getThreadRecorder().start();
+    }
+
+    TraceScope traceScope("run", "visualizer");
+    run(widget);
+}
+
 void AlgorithmVisualizer::clear()
 {
     if(visualizationTimer.isActive())
@@ -66,3 +86,36 @@ void AlgorithmVisualizer::setStepTime(int newStepTime)
 
     emit stepTimeChanged();
 }
+
+bool AlgorithmVisualizer::getRecordTrace() const
+{
+    return recordTrace;
+}
+
+void AlgorithmVisualizer::setRecordTrace(bool newRecordTrace)
+{
+    if (recordTrace == newRecordTrace)
+    {
+        return;
+    }
+
+    recordTrace = newRecordTrace;
+    emit recordTraceChanged();
+}
+
+void AlgorithmVisualizer::finishTrace()
+{
+    TraceRecorder& traceRecorder = TraceRecorder::getThreadRecorder();
+    if(!traceRecorder.isRecording())
+    {
+        return;
+    }
+
+    traceRecorder.stop();
+
+    QString outInfo;
+    if(!TraceFile::appendEvents(traceRecorder.takeEvents(), outInfo))
+    {
+        qWarning().noquote() << outInfo;
+    }
+}
@@ -11,11 +11,14 @@ class AlgorithmVisualizer : public QObject
     Q_OBJECT
 
     Q_PROPERTY(int stepTime READ getStepTime WRITE setStepTime NOTIFY stepTimeChanged FINAL)
+    Q_PROPERTY(bool recordTrace READ getRecordTrace WRITE setRecordTrace NOTIFY recordTraceChanged FINAL)
 public:
     AlgorithmVisualizer(QObject *parent = nullptr);
     virtual ~AlgorithmVisualizer() = 0;
 
     virtual void run(QWidget* widget) = 0;
+
+    void start(QWidget* widget);
     virtual void clear();
 
     virtual bool isDataStructureSupported(const DataStructure* dataStructure, QString& outInfo) const;
@@ -26,10 +29,14 @@ public:
     int getStepTime() const;
     void setStepTime(int newStepTime);
 
+    bool getRecordTrace() const;
+    void setRecordTrace(bool newRecordTrace);
+
 signals:
     void finished();
 
     void stepTimeChanged();
+    void recordTraceChanged();
 
 protected:
     virtual void updateVisualization() = 0;
@@ -38,6 +45,10 @@ protected:
 
     QTimer visualizationTimer;
     int stepTime;
+    bool recordTrace;
+
+private:
+    void finishTrace();
 };
 
 #endif // ALGORITHMVISUALIZER_H
@@ -0,0 +1,93 @@
+#include "algorithm_workspace.h"
+
+#include <limits>
+
+void VisitedMarks::reset(qsizetype nodesNum)
+{
+    // new stamps get the current epoch, which clear leaves behind
+    if(stamps.size() < nodesNum)
+    {
+        stamps.resize(nodesNum, epoch);
+    }
+
+    clear();
+}
+
+void VisitedMarks::clear()
+{
+    if(epoch == std::numeric_limits<quint32>::max())
+    {
+        // a stamp of the wrapped epoch could look visited, once in 2^32 clears every stamp is written again
+        stamps.fill(0);
+        epoch = 0;
+    }
+
+    epoch++;
+}
+
+void VisitedMarks::reserve(qsizetype nodesNum)
+{
+    stamps.reserve(nodesNum);
+}
+
+void AlgorithmWorkspace::reset()
+{
+    takenIntListsNum = 0;
+    takenVisitedMarksNum = 0;
+}
+
+void AlgorithmWorkspace::reserve(qsizetype nodesNum)
+{
+    for(QList<int>& intList : intLists)
+    {
+        intList.reserve(nodesNum);
+    }
+
+    for(VisitedMarks& marks : visitedMarks)
+    {
+        marks.reserve(nodesNum);
+    }
+}
+
+void AlgorithmWorkspace::release()
+{
+    intLists.clear();
+    visitedMarks.clear();
+
+    reset();
+}
+
+QList<int> &AlgorithmWorkspace::takeInts()
+{
+    if(takenIntListsNum == intLists.size())
+    {
+        intLists.emplace_back();
+    }
+
+    // keeps the capacity as long as the list is not shared
+    QList<int>& intList = intLists[takenIntListsNum++];
+    intList.clear();
+
+    return intList;
+}
+
+QList<int> &AlgorithmWorkspace::takeInts(qsizetype nodesNum, int value)
+{
+    QList<int>& intList = takeInts();
+    intList.fill(value, nodesNum);
+
+    return intList;
+}
+
+VisitedMarks &AlgorithmWorkspace::takeVisitedMarks(qsizetype nodesNum)
+{
+    if(takenVisitedMarksNum == visitedMarks.size())
+    {
+        visitedMarks.emplace_back();
+    }
+
+    VisitedMarks& marks = visitedMarks[takenVisitedMarksNum++];
+    marks.reset(nodesNum);
+
+    return marks;
+}
@@ -0,0 +1,79 @@
+#ifndef ALGORITHM_WORKSPACE_H
+#define ALGORITHM_WORKSPACE_H
+
+#include <QList>
+
+#include <deque>
+
+/**
+ * Visited flags of the nodes, cleared by moving to the next epoch instead of writing every node.
+ * A node is visited when its stamp equals the current epoch.
+ */
+class VisitedMarks
+{
+public:
+    // all nodes unvisited, stamps are rewritten only when the size grows or the epoch wraps around
+    void reset(qsizetype nodesNum);
+
+    void clear();
+
+    void reserve(qsizetype nodesNum);
+
+    bool isVisited(int node) const
+    {
+        return stamps[node] == epoch;
+    }
+
+    void visit(int node)
+    {
+        stamps[node] = epoch;
+    }
+
+    bool tryVisit(int node)
+    {
+        if(stamps[node] == epoch)
+        {
+            return false;
+        }
+
+        stamps[node] = epoch;
+        return true;
+    }
+
+private:
+    QList<quint32> stamps;
+    quint32 epoch = 0;
+};
+
+/**
+ * Scratch memory of an algorithm, bump allocated from pools that keep their buffers and capacity from one execute to the next.
+ * reset hands the whole pool out again in O(1), so a sweep stops paying for allocation once the buffers have grown to the largest size.
+ * References stay valid until the next reset, a buffer must not be moved out or shared.
+ */
+class AlgorithmWorkspace
+{
+public:
+    // every buffer can be taken again, nothing is freed or cleared
+    void reset();
+
+    void reserve(qsizetype nodesNum);
+
+    void release();
+
+    // an empty list that keeps the capacity of its previous use
+    QList<int>& takeInts();
+
+    QList<int>& takeInts(qsizetype nodesNum, int value);
+
+    VisitedMarks& takeVisitedMarks(qsizetype nodesNum);
+
+private:
+    // a deque never moves its elements when it grows, so taken references survive later takes
+    std::deque<QList<int>> intLists;
+    std::deque<VisitedMarks> visitedMarks;
+
+    size_t takenIntListsNum = 0;
+    size_t takenVisitedMarksNum = 0;
+};
+
+#endif // ALGORITHM_WORKSPACE_H
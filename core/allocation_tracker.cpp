@@ -0,0 +1,197 @@
+#include "allocation_tracker.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#ifdef ALLOCATION_TRACKER_ENABLED
+
+#include <malloc.h>
+
+namespace
+{
+    struct ThreadAllocationCounters
+    {
+        bool tracking;
+        quint64 allocationsNum;
+        quint64 allocatedBytes;
+        qint64 liveBytes;
+        qint64 peakLiveBytes;
+    };
+
+    // trivially constructed, so it is safe to touch from operator new at any point of the thread lifetime
+    thread_local ThreadAllocationCounters threadCounters{};
+
+    // plain malloc blocks, so a module with its own operator delete can free them
+    std::size_t getBlockSize(void* block) noexcept
+    {
+#ifdef _WIN32
+        return _msize(block);
+#else
+        return malloc_usable_size(block);
+#endif
+    }
+
+    void* allocate(std::size_t size) noexcept
+    {
+        void* block = std::malloc(size);
+        if(!block)
+        {
+            return nullptr;
+        }
+
+        ThreadAllocationCounters& counters = threadCounters;
+        if(counters.tracking)
+        {
+            counters.allocationsNum++;
+            counters.allocatedBytes += size;
+            counters.liveBytes += static_cast<qint64>(getBlockSize(block));
+            counters.peakLiveBytes = std::max(counters.peakLiveBytes, counters.liveBytes);
+        }
+
+        return block;
+    }
+
+    void deallocate(void* block) noexcept
+    {
+        if(!block)
+        {
+            return;
+        }
+
+        ThreadAllocationCounters& counters = threadCounters;
+        if(counters.tracking)
+        {
+            counters.liveBytes -= static_cast<qint64>(getBlockSize(block));
+        }
+
+        std::free(block);
+    }
+
+    void* allocateOrThrow(std::size_t size)
+    {
+        if(size == 0)
+        {
+            size = 1;
+        }
+
+        while(true)
+        {
+            if(void* pointer = allocate(size))
+            {
+                return pointer;
+            }
+
+            std::new_handler handler = std::get_new_handler();
+            if(!handler)
+            {
+                throw std::bad_alloc();
+            }
+
+            handler();
+        }
+    }
+
+    void* allocateOrNull(std::size_t size) noexcept
+    {
+        try
+        {
+            return allocateOrThrow(size);
+        }
+        catch(...)
+        {
+            return nullptr;
+        }
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    return allocateOrThrow(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocateOrThrow(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocateOrNull(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocateOrNull(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+    deallocate(pointer);
+}
+
+bool AllocationTracker::isAvailable()
+{
+    return true;
+}
+
+void AllocationTracker::startTracking()
+{
+    threadCounters = ThreadAllocationCounters{true, 0, 0, 0, 0};
+}
+
+AllocationStatistics AllocationTracker::stopTracking()
+{
+    ThreadAllocationCounters& counters = threadCounters;
+    counters.tracking = false;
+
+    AllocationStatistics statistics;
+    statistics.allocationsNum = counters.allocationsNum;
+    statistics.allocatedBytes = counters.allocatedBytes;
+    statistics.peakLiveBytes = counters.peakLiveBytes;
+
+    return statistics;
+}
+
+#else
+
+bool AllocationTracker::isAvailable()
+{
+    return false;
+}
+
+void AllocationTracker::startTracking()
+{
+}
+
+AllocationStatistics AllocationTracker::stopTracking()
+{
+    return AllocationStatistics();
+}
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include <QtGlobal>
+
+struct AllocationStatistics
+{
+    quint64 allocationsNum = 0;
+    quint64 allocatedBytes = 0;
+    qint64 peakLiveBytes = 0; // usable sizes of the blocks, relative to the live bytes when tracking started
+};
+
+/**
+ * Counts heap allocations of the calling thread between startTracking and stopTracking.
+ * Global operator new/delete are replaced only when the project is configured with ALGORITHMS_ALLOCATION_TRACKER,
+ * the counters are thread-local, so tracking one benchmark does not see allocations of other threads.
+ * Memory allocated with malloc directly (for example the buffers of QList) is not seen.
+ */
+class AllocationTracker
+{
+public:
+    static bool isAvailable();
+
+    static void startTracking();
+    static AllocationStatistics stopTracking();
+};
+
+#endif // ALLOCATION_TRACKER_H
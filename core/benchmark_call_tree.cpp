@@ -0,0 +1,78 @@
+#include "benchmark_call_tree.h"
+
+#include <QJsonArray>
+
+#include <cmath>
+
+QList<int> BenchmarkCallTree::getChildren(int parent) const
+{
+    QList<int> children;
+    for(int i = parent + 1; i < nodes.size(); ++i)
+    {
+        if(nodes[i].parent == parent)
+        {
+            children.append(i);
+        }
+    }
+
+    return children;
+}
+
+QJsonObject BenchmarkCallTree::toJsonObject() const
+{
+    QJsonArray nodesAsJsonArray;
+    for(const BenchmarkCallTreeNode& node : nodes)
+    {
+        QJsonObject nodeAsJsonObject;
+        nodeAsJsonObject["name"] = node.name;
+        nodeAsJsonObject["parent"] = node.parent;
+        nodeAsJsonObject["total"] = node.totalCycles;
+        nodeAsJsonObject["self"] = node.selfCycles;
+        nodeAsJsonObject["calls"] = node.callsNum;
+
+        nodesAsJsonArray.append(nodeAsJsonObject);
+    }
+
+    QJsonObject jsonObject;
+    jsonObject["x"] = x;
+    jsonObject["nodes"] = nodesAsJsonArray;
+
+    return jsonObject;
+}
+
+BenchmarkCallTree BenchmarkCallTree::fromJsonObject(const QJsonObject &jsonObject)
+{
+    BenchmarkCallTree callTree;
+    callTree.x = jsonObject["x"].toDouble();
+
+    const QJsonArray nodesAsJsonArray = jsonObject["nodes"].toArray();
+    for(const QJsonValue& nodeAsJsonValue : nodesAsJsonArray)
+    {
+        const QJsonObject nodeAsJsonObject = nodeAsJsonValue.toObject();
+
+        BenchmarkCallTreeNode node;
+        node.name = nodeAsJsonObject["name"].toString();
+        node.parent = nodeAsJsonObject["parent"].toInt(-1);
+        node.totalCycles = nodeAsJsonObject["total"].toDouble();
+        node.selfCycles = nodeAsJsonObject["self"].toDouble();
+        node.callsNum = nodeAsJsonObject["calls"].toDouble();
+
+        callTree.nodes.append(node);
+    }
+
+    return callTree;
+}
+
+const BenchmarkCallTree *BenchmarkCallTree::findNearest(const QList<BenchmarkCallTree> &callTrees, qreal x)
+{
+    const BenchmarkCallTree* nearestCallTree = nullptr;
+    for(const BenchmarkCallTree& callTree : callTrees)
+    {
+        if(!nearestCallTree || std::abs(callTree.x - x) < std::abs(nearestCallTree->x - x))
+        {
+            nearestCallTree = &callTree;
+        }
+    }
+
+    return nearestCallTree;
+}
@@ -0,0 +1,37 @@
+#ifndef BENCHMARK_CALL_TREE_H
+#define BENCHMARK_CALL_TREE_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+// One timer of the call tree, cycles and calls are averaged over the measured runs of the point
+struct BenchmarkCallTreeNode
+{
+    QString name;
+    int parent = -1; // index in the nodes of the same tree, -1 for timers not nested in another timer
+    qreal totalCycles = 0.0;
+    qreal selfCycles = 0.0; // total without the cycles of the nested timers
+    qreal callsNum = 0.0;
+};
+
+// Nested BENCHMARK_SCOPED_TIMER sites of a single size point
+struct BenchmarkCallTree
+{
+    qreal x = 0.0;
+    QList<BenchmarkCallTreeNode> nodes; // parents always come before their children
+
+    bool isEmpty() const
+    {
+        return nodes.isEmpty();
+    }
+
+    QList<int> getChildren(int parent) const;
+
+    QJsonObject toJsonObject() const;
+    static BenchmarkCallTree fromJsonObject(const QJsonObject& jsonObject);
+
+    static const BenchmarkCallTree* findNearest(const QList<BenchmarkCallTree>& callTrees, qreal x);
+};
+
+#endif // BENCHMARK_CALL_TREE_H
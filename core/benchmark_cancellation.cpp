@@ -0,0 +1,82 @@
+#include "benchmark_cancellation.h"
+
+void BenchmarkCancellationToken::cancel()
+{
+    cancelled.store(true, std::memory_order_relaxed);
+}
+
+bool BenchmarkCancellationToken::isCancelled() const
+{
+    return cancelled.load(std::memory_order_relaxed);
+}
+
+void BenchmarkCancellationToken::reset()
+{
+    cancelled.store(false, std::memory_order_relaxed);
+    startBudget(0);
+}
+
+void BenchmarkCancellationToken::startBudget(qint64 newBudgetMs)
+{
+    budgetMs = newBudgetMs;
+    spentMs = 0;
+    paused = false;
+    truncated = false;
+    overBudget = false;
+
+    if(budgetMs > 0)
+    {
+        budgetTimer.start();
+    }
+}
+
+void BenchmarkCancellationToken::stopBudget()
+{
+    budgetMs = 0;
+}
+
+void BenchmarkCancellationToken::pauseBudget()
+{
+    spentMs += budgetTimer.elapsed();
+    paused = true;
+    budgetTimer.start();
+}
+
+void BenchmarkCancellationToken::resumeBudget()
+{
+    paused = false;
+    budgetTimer.start();
+}
+
+bool BenchmarkCancellationToken::shouldStop()
+{
+    if(isCancelled())
+    {
+        truncated = true;
+        return true;
+    }
+
+    if(budgetMs > 0 && budgetTimer.elapsed() + (paused ? 0 : spentMs) > budgetMs)
+    {
+        truncated = true;
+        overBudget = true;
+        return true;
+    }
+
+    return false;
+}
+
+bool BenchmarkCancellationToken::isTruncated() const
+{
+    return truncated;
+}
+
+bool BenchmarkCancellationToken::isOverBudget() const
+{
+    return overBudget;
+}
+
+qint64 BenchmarkCancellationToken::getBudgetMs() const
+{
+    return budgetMs;
+}
@@ -0,0 +1,57 @@
+#ifndef BENCHMARK_CANCELLATION_H
+#define BENCHMARK_CANCELLATION_H
+
+#include <QElapsedTimer>
+
+#include <atomic>
+
+/**
+ * Stops a running benchmark from another thread and bounds the time of a single sweep iteration.
+ * Long kernels poll shouldStop every few outer-loop steps and return early when it says so,
+ * the iteration they were measuring is truncated then.
+ */
+class BenchmarkCancellationToken
+{
+public:
+    // outer-loop steps between two polls of kernels whose steps are short
+    static constexpr int PollInterval = 256;
+
+    // safe to call from any thread
+    void cancel();
+    bool isCancelled() const;
+
+    void reset();
+
+    // the budget of the next iteration starts now and clears the previous truncation, 0 or less means no budget
+    void startBudget(qint64 budgetMs);
+
+    // the budget no longer applies, a truncation it already caused is kept
+    void stopBudget();
+
+    // the time until resumeBudget is not spent from the budget, the unmeasured work in between gets a whole budget of its own
+    void pauseBudget();
+    void resumeBudget();
+
+    // only the benchmark thread calls it
+    bool shouldStop();
+
+    // a kernel stopped early since startBudget, its work and the time measured for it are incomplete
+    bool isTruncated() const;
+
+    bool isOverBudget() const;
+
+    qint64 getBudgetMs() const;
+
+private:
+    std::atomic<bool> cancelled{false};
+
+    QElapsedTimer budgetTimer;
+    qint64 budgetMs = 0;
+    qint64 spentMs = 0; // before the pause
+    bool paused = false;
+
+    bool truncated = false;
+    bool overBudget = false;
+};
+
+#endif // BENCHMARK_CANCELLATION_H
@@ -0,0 +1,133 @@
+#include "benchmark_checkpoint.h"
+#include "benchmark_results_store.h"
+
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+
+bool BenchmarkCheckpoint::isEmpty() const
+{
+    return results.isEmpty();
+}
+
+QString BenchmarkCheckpoint::getFilePath(const QString &algorithmName)
+{
+    // names like "Eulerian Path / (Hierholzer's algorithm)" would point into a directory
+    static const QString ForbiddenCharacters = "<>:\"/\\|?*";
+
+    QString fileName = algorithmName;
+    for(QChar& character : fileName)
+    {
+        if(character.unicode() < 0x20 || ForbiddenCharacters.contains(character))
+        {
+            character = QLatin1Char('_');
+        }
+    }
+
+    return FilePrefix + fileName + ".json";
+}
+
+QStringList BenchmarkCheckpoint::findAlgorithmNames()
+{
+    QStringList algorithmNames;
+
+    const QStringList fileNames = QDir::current().entryList({FilePrefix + "*.json"}, QDir::Files, QDir::Time);
+    for(const QString& fileName : fileNames)
+    {
+        QFile checkpointFile(fileName);
+        if(!checkpointFile.open(QIODevice::ReadOnly))
+        {
+            continue;
+        }
+
+        const QString algorithmName = QJsonDocument::fromJson(checkpointFile.readAll()).object()["algorithmName"].toString();
+        if(!algorithmName.isEmpty())
+        {
+            algorithmNames.append(algorithmName);
+        }
+    }
+
+    return algorithmNames;
+}
+
+bool BenchmarkCheckpoint::save(const QString &filePath, QString &outInfo) const
+{
+    QJsonArray resultsAsJsonArray;
+    for(const AlgorithmBenchmarkResult& resultData : results)
+    {
+        resultsAsJsonArray.append(BenchmarkResultsStore::resultToJsonObject(resultData));
+    }
+
+    QJsonObject checkpointAsJsonObject;
+    checkpointAsJsonObject["algorithmName"] = algorithmName;
+    checkpointAsJsonObject["results"] = resultsAsJsonArray;
+    // as a string, a double cannot hold every 64-bit seed
+    checkpointAsJsonObject["inputSeed"] = QString::number(inputSeed);
+    checkpointAsJsonObject["nextIteration"] = nextIteration;
+    checkpointAsJsonObject["sweepState"] = sweepState;
+
+    QSaveFile checkpointFile(filePath);
+    if(!checkpointFile.open(QIODevice::WriteOnly))
+    {
+        outInfo = "Cannot open " + filePath + " for writing: " + checkpointFile.errorString();
+        return false;
+    }
+
+    checkpointFile.write(QJsonDocument(checkpointAsJsonObject).toJson(QJsonDocument::Compact));
+
+    if(!checkpointFile.commit())
+    {
+        outInfo = "Cannot write to " + filePath + ": " + checkpointFile.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+bool BenchmarkCheckpoint::load(const QString &filePath, QString &outInfo)
+{
+    QFile checkpointFile(filePath);
+    if(!checkpointFile.open(QIODevice::ReadOnly))
+    {
+        outInfo = "Cannot open " + filePath + ": " + checkpointFile.errorString();
+        return false;
+    }
+
+    const QJsonDocument jsonDoc = QJsonDocument::fromJson(checkpointFile.readAll());
+    if(!jsonDoc.isObject())
+    {
+        outInfo = filePath + " is not a benchmark checkpoint.";
+        return false;
+    }
+
+    const QJsonObject checkpointAsJsonObject = jsonDoc.object();
+
+    algorithmName = checkpointAsJsonObject["algorithmName"].toString();
+
+    results.clear();
+
+    const QJsonArray resultsAsJsonArray = checkpointAsJsonObject["results"].toArray();
+    for(const QJsonValue& resultAsJsonValue : resultsAsJsonArray)
+    {
+        results.append(BenchmarkResultsStore::resultFromJsonObject(resultAsJsonValue.toObject()));
+    }
+
+    inputSeed = checkpointAsJsonObject["inputSeed"].toString().toULongLong();
+    nextIteration = checkpointAsJsonObject["nextIteration"].toInt();
+    sweepState = checkpointAsJsonObject["sweepState"].toObject();
+
+    if(results.isEmpty())
+    {
+        outInfo = filePath + " holds no results.";
+        return false;
+    }
+
+    return true;
+}
+
+void BenchmarkCheckpoint::remove(const QString &filePath)
+{
+    QFile::remove(filePath);
+}
@@ -0,0 +1,37 @@
+#ifndef BENCHMARK_CHECKPOINT_H
+#define BENCHMARK_CHECKPOINT_H
+
+#include "benchmark_timers.h"
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+/**
+ * State of an unfinished sweep. The partial results carry the run info, so the settings of the run
+ * are restored from them, the seed and the next iteration let the sweep rebuild exactly the inputs it would have built.
+ */
+struct BenchmarkCheckpoint
+{
+    static inline const QString FilePrefix = "benchmark checkpoint ";
+
+    QString algorithmName; // the file name may have replaced some of its characters
+    QList<AlgorithmBenchmarkResult> results; // one per representation, the points measured so far
+    quint64 inputSeed = 0;
+    int nextIteration = 0;
+    QJsonObject sweepState; // totals and settings of the sweep the run info does not hold
+
+    bool isEmpty() const;
+
+    static QString getFilePath(const QString& algorithmName);
+
+    static QStringList findAlgorithmNames();
+
+    // written to a temporary file first, so a crash while saving keeps the previous checkpoint
+    bool save(const QString& filePath, QString& outInfo) const;
+    bool load(const QString& filePath, QString& outInfo);
+
+    static void remove(const QString& filePath);
+};
+
+#endif // BENCHMARK_CHECKPOINT_H
@@ -0,0 +1,164 @@
+#include "benchmark_comparison.h"
+#include "benchmark_timers.h"
+
+#include <QHash>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    bool hasEnoughSamples(const BenchmarkStatistics& baseline, const BenchmarkStatistics& candidate)
+    {
+        return baseline.samplesNum >= BenchmarkComparison::MinSamplesNum && candidate.samplesNum >= BenchmarkComparison::MinSamplesNum;
+    }
+
+    bool isDifferenceSignificant(const BenchmarkStatistics& baseline, const BenchmarkStatistics& candidate)
+    {
+        const qreal standardError = std::sqrt(baseline.stddev * baseline.stddev / baseline.samplesNum
+                                              + candidate.stddev * candidate.stddev / candidate.samplesNum);
+        if(standardError == 0.0)
+        {
+            return baseline.mean != candidate.mean;
+        }
+
+        return std::abs(candidate.mean - baseline.mean) / standardError > BenchmarkComparison::SignificantT;
+    }
+}
+
+BenchmarkComparison BenchmarkComparison::compare(const AlgorithmBenchmarkResult &baseline, const AlgorithmBenchmarkResult &candidate, qreal minRelativeChange)
+{
+    BenchmarkComparison comparison;
+
+    const bool matchByIteration = baseline.mainSeriesInputs.size() == baseline.mainSeries.size()
+                                  && candidate.mainSeriesInputs.size() == candidate.mainSeries.size();
+
+    auto getPointKey = [matchByIteration](const AlgorithmBenchmarkResult& resultData, int index)
+    {
+        return matchByIteration ? qRound64(resultData.mainSeriesInputs[index].iteration) : static_cast<qint64>(index);
+    };
+
+    QHash<qint64, int> baselineKeyToIndex;
+    for(int i = 0; i < baseline.mainSeries.size(); ++i)
+    {
+        baselineKeyToIndex.insert(getPointKey(baseline, i), i);
+    }
+
+    const bool hasStatistics = baseline.mainSeriesStatistics.size() == baseline.mainSeries.size()
+                               && candidate.mainSeriesStatistics.size() == candidate.mainSeries.size();
+
+    qreal logRatiosSum = 0.0;
+
+    for(int i = 0; i < candidate.mainSeries.size(); ++i)
+    {
+        const auto it = baselineKeyToIndex.constFind(getPointKey(candidate, i));
+        if(it == baselineKeyToIndex.constEnd())
+        {
+            continue;
+        }
+
+        const int baselineIndex = it.value();
+
+        BenchmarkPointComparison pointComparison;
+        pointComparison.candidatePoint = candidate.mainSeries[i];
+        pointComparison.baselineY = baseline.mainSeries[baselineIndex].y();
+
+        if(pointComparison.baselineY <= 0.0 || pointComparison.candidatePoint.y() <= 0.0)
+        {
+            continue;
+        }
+
+        pointComparison.ratio = pointComparison.candidatePoint.y() / pointComparison.baselineY;
+
+        if(hasStatistics)
+        {
+            const BenchmarkStatistics& baselineStatistics = baseline.mainSeriesStatistics[baselineIndex];
+            const BenchmarkStatistics& candidateStatistics = candidate.mainSeriesStatistics[i];
+
+            pointComparison.hasEnoughSamples = hasEnoughSamples(baselineStatistics, candidateStatistics);
+            pointComparison.isSignificant = pointComparison.hasEnoughSamples && isDifferenceSignificant(baselineStatistics, candidateStatistics);
+        }
+
+        comparison.insufficientSamplesNum += pointComparison.hasEnoughSamples ? 0 : 1;
+
+        pointComparison.isRegression = pointComparison.isSignificant && pointComparison.ratio > 1.0 + minRelativeChange;
+        pointComparison.isImprovement = pointComparison.isSignificant && pointComparison.ratio < 1.0 - minRelativeChange;
+
+        comparison.regressionsNum += pointComparison.isRegression ? 1 : 0;
+        comparison.improvementsNum += pointComparison.isImprovement ? 1 : 0;
+
+        logRatiosSum += std::log(pointComparison.ratio);
+
+        comparison.points.append(pointComparison);
+    }
+
+    if(!comparison.points.isEmpty())
+    {
+        comparison.geometricMeanRatio = std::exp(logRatiosSum / comparison.points.size());
+    }
+
+    return comparison;
+}
+
+QList<QPointF> BenchmarkComparison::getRegressionPoints() const
+{
+    QList<QPointF> regressionPoints;
+    for(const BenchmarkPointComparison& pointComparison : points)
+    {
+        if(pointComparison.isRegression)
+        {
+            regressionPoints.append(pointComparison.candidatePoint);
+        }
+    }
+
+    return regressionPoints;
+}
+
+void BenchmarkComparison::appendInfo(QString &infoText, int shownPointsNum) const
+{
+    infoText.append("compared points : " + QString::number(points.size()));
+    infoText.append("\n");
+
+    infoText.append("geometric mean ratio : " + QString::number(geometricMeanRatio, 'f', 3));
+    infoText.append("\n");
+
+    infoText.append("significant regressions : " + QString::number(regressionsNum)
+                    + ", improvements : " + QString::number(improvementsNum));
+    infoText.append("\n");
+
+    if(insufficientSamplesNum > 0)
+    {
+        infoText.append("insufficient samples : " + QString::number(insufficientSamplesNum) + " points with fewer than "
+                        + QString::number(MinSamplesNum) + " samples on a side are not tested, raise the repetitions number of both runs");
+        infoText.append("\n");
+    }
+
+    QList<BenchmarkPointComparison> sortedPoints = points;
+    std::sort(sortedPoints.begin(), sortedPoints.end(), [](const BenchmarkPointComparison& a, const BenchmarkPointComparison& b)
+    {
+        return std::abs(std::log(a.ratio)) > std::abs(std::log(b.ratio));
+    });
+
+    for(int i = 0; i < sortedPoints.size() && i < shownPointsNum; ++i)
+    {
+        const BenchmarkPointComparison& pointComparison = sortedPoints[i];
+
+        QString mark;
+        if(pointComparison.isRegression)
+        {
+            mark = " REGRESSION";
+        }
+        else if(pointComparison.isImprovement)
+        {
+            mark = " improvement";
+        }
+        else if(!pointComparison.hasEnoughSamples)
+        {
+            mark = " insufficient samples";
+        }
+
+        infoText.append("  x = " + QString::number(pointComparison.candidatePoint.x(), 'g', 6)
+                        + " : ratio " + QString::number(pointComparison.ratio, 'f', 3) + mark);
+        infoText.append("\n");
+    }
+}
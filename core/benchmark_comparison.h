@@ -0,0 +1,46 @@
+#ifndef BENCHMARK_COMPARISON_H
+#define BENCHMARK_COMPARISON_H
+
+#include <QList>
+#include <QPointF>
+#include <QString>
+
+struct AlgorithmBenchmarkResult;
+
+struct BenchmarkPointComparison
+{
+    QPointF candidatePoint;
+    qreal baselineY = 0.0;
+    qreal ratio = 1.0; // candidate / baseline, above 1 means slower
+    bool hasEnoughSamples = false; // both sides measured at least MinSamplesNum times
+    bool isSignificant = false;
+    bool isRegression = false;
+    bool isImprovement = false;
+};
+
+/**
+ * Point by point comparison of a candidate run against a baseline. Points are matched by iteration
+ * when both runs know their inputs, otherwise by position. A difference is significant when Welch's t
+ * exceeds SignificantT. Points with fewer than MinSamplesNum samples on either side have no spread to test
+ * against, they are reported as insufficient samples and never as significant.
+ * Only significant changes larger than minRelativeChange count as regressions or improvements.
+ */
+struct BenchmarkComparison
+{
+    static constexpr qreal SignificantT = 2.0;
+    static constexpr int MinSamplesNum = 2;
+
+    QList<BenchmarkPointComparison> points;
+    int regressionsNum = 0;
+    int improvementsNum = 0;
+    int insufficientSamplesNum = 0;
+    qreal geometricMeanRatio = 1.0;
+
+    static BenchmarkComparison compare(const AlgorithmBenchmarkResult& baseline, const AlgorithmBenchmarkResult& candidate, qreal minRelativeChange = 0.05);
+
+    QList<QPointF> getRegressionPoints() const;
+
+    void appendInfo(QString& infoText, int shownPointsNum = 10) const;
+};
+
+#endif // BENCHMARK_COMPARISON_H
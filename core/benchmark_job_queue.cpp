@@ -0,0 +1,363 @@
+#include "benchmark_job_queue.h"
+#include "algorithm.h"
+#include "algorithm_texts.h"
+#include "benchmark_results_store.h"
+#include "data_structure_builder.h"
+
+#include <algorithm>
+
+namespace
+{
+    bool readProperties(const QObject* object, const QVariantHash& properties, QVariantHash& outValues, QString& outInfo)
+    {
+        for(auto it = properties.constBegin(); it != properties.constEnd(); ++it)
+        {
+            if(object->metaObject()->indexOfProperty(it.key().toUtf8().constData()) < 0)
+            {
+                outInfo = AlgorithmTexts::UnknownJobProperty + it.key() + " in " + object->objectName();
+                return false;
+            }
+
+            outValues[it.key()] = object->property(it.key().toUtf8().constData());
+        }
+
+        return true;
+    }
+
+    void writeProperties(QObject* object, const QVariantHash& properties)
+    {
+        for(auto it = properties.constBegin(); it != properties.constEnd(); ++it)
+        {
+            object->setProperty(it.key().toUtf8().constData(), it.value());
+        }
+    }
+}
+
+QString BenchmarkJob::getDescription() const
+{
+    QString description = algorithm->objectName();
+    if(!builderName.isEmpty())
+    {
+        description += " on " + builderName;
+    }
+
+    return description + ", priority " + QString::number(priority);
+}
+
+BenchmarkJobQueue::BenchmarkJobQueue(QObject *parent)
+    : QObject(parent)
+    , running(false)
+    , finishedJobsNum(0)
+    , failedJobsNum(0)
+{
+
+}
+
+BenchmarkJobQueue::~BenchmarkJobQueue()
+{
+    stop();
+}
+
+void BenchmarkJobQueue::addJob(const BenchmarkJob &job)
+{
+    // stable, jobs of the same priority keep the order they were added in
+    auto it = std::upper_bound(pendingJobs.begin(), pendingJobs.end(), job, [](const BenchmarkJob& newJob, const BenchmarkJob& pendingJob)
+    {
+        return newJob.priority > pendingJob.priority;
+    });
+
+    pendingJobs.insert(it, job);
+}
+
+bool BenchmarkJobQueue::start(const QString &schedule, const QList<int> &workerCores, QString &outInfo)
+{
+    if(running)
+    {
+        outInfo = AlgorithmTexts::SuiteRunning;
+        return false;
+    }
+
+    if(pendingJobs.isEmpty())
+    {
+        outInfo = AlgorithmTexts::NoBenchmarkJobs;
+        return false;
+    }
+
+    if(schedule == BenchmarkJobSchedules::Sequential)
+    {
+        freeCores = {workerCores.value(0, -1)};
+    }
+    else if(schedule == BenchmarkJobSchedules::Parallel)
+    {
+        if(workerCores.isEmpty())
+        {
+            outInfo = AlgorithmTexts::NoWorkerCores;
+            return false;
+        }
+
+        freeCores = workerCores;
+    }
+    else
+    {
+        outInfo = AlgorithmTexts::UnknownSchedule + schedule;
+        return false;
+    }
+
+    // dedicated workers, so single benchmarks started from the window never wait for the suite
+    workerPool.setMaxThreadCount(freeCores.size());
+
+    running = true;
+    finishedJobsNum = 0;
+    failedJobsNum = 0;
+
+    startNextJobs();
+
+    return true;
+}
+
+void BenchmarkJobQueue::stop()
+{
+    pendingJobs.clear();
+
+    for(const RunningJob& runningJob : std::as_const(runningJobs))
+    {
+        runningJob.job.algorithm->requestEnd();
+    }
+
+    workerPool.waitForDone();
+
+    // the ends of the runs are still queued, the jobs are finished here instead
+    const QList<RunningJob> stoppedJobs = runningJobs.values();
+    runningJobs.clear();
+
+    for(const RunningJob& runningJob : stoppedJobs)
+    {
+        disconnect(runningJob.resultConnection);
+        restoreJob(runningJob);
+        finishJob(runningJob, AlgorithmTexts::JobStopped);
+    }
+
+    freeCores.clear();
+
+    if(running)
+    {
+        running = false;
+        emit allJobsFinished(finishedJobsNum, failedJobsNum);
+    }
+}
+
+bool BenchmarkJobQueue::isRunning() const
+{
+    return running;
+}
+
+qsizetype BenchmarkJobQueue::getPendingJobsNum() const
+{
+    return pendingJobs.size();
+}
+
+qsizetype BenchmarkJobQueue::getRunningJobsNum() const
+{
+    return runningJobs.size();
+}
+
+void BenchmarkJobQueue::startNextJobs()
+{
+    auto isRunningAlone = [](const RunningJob& runningJob)
+    {
+        return runningJob.job.runAlone || runningJob.job.algorithm->isParallel();
+    };
+
+    while(running && !freeCores.isEmpty() && !pendingJobs.isEmpty())
+    {
+        if(std::any_of(runningJobs.cbegin(), runningJobs.cend(), isRunningAlone))
+        {
+            break;
+        }
+
+        // the first job whose algorithm is free, a job that has to run alone at the front waits for the others to end
+        qsizetype jobIndex = -1;
+        for(qsizetype i = 0; i < pendingJobs.size(); ++i)
+        {
+            const BenchmarkJob& job = pendingJobs[i];
+            if((job.runAlone || job.algorithm->isParallel()) && !runningJobs.isEmpty())
+            {
+                break;
+            }
+
+            if(!runningJobs.contains(job.algorithm))
+            {
+                jobIndex = i;
+                break;
+            }
+        }
+
+        if(jobIndex < 0)
+        {
+            break;
+        }
+
+        RunningJob runningJob;
+        runningJob.job = pendingJobs.takeAt(jobIndex);
+        runningJob.core = freeCores.first();
+
+        QString outInfo;
+        if(!setUpJob(runningJob, outInfo))
+        {
+            restoreJob(runningJob);
+            finishJob(runningJob, outInfo);
+            continue;
+        }
+
+        freeCores.removeFirst();
+
+        Algorithm* algorithm = runningJob.job.algorithm;
+
+        runningJob.resultConnection = connect(algorithm, &Algorithm::finished, this, [this, algorithm](const AlgorithmBenchmarkResult& resultData)
+        {
+            onJobResult(algorithm, resultData);
+        });
+
+        runningJobs.insert(algorithm, runningJob);
+        emit jobStarted(runningJob.job);
+
+        workerPool.start([this, algorithm]()
+        {
+            algorithm->run();
+
+            QMetaObject::invokeMethod(this, [this, algorithm]()
+            {
+                onJobRunEnded(algorithm);
+            }, Qt::QueuedConnection);
+        });
+    }
+
+    if(running && runningJobs.isEmpty() && pendingJobs.isEmpty())
+    {
+        running = false;
+        emit allJobsFinished(finishedJobsNum, failedJobsNum);
+    }
+}
+
+bool BenchmarkJobQueue::setUpJob(RunningJob &runningJob, QString &outInfo) const
+{
+    const BenchmarkJob& job = runningJob.job;
+    Algorithm* algorithm = job.algorithm;
+
+    runningJob.previousBuilderName = algorithm->getSelectedBuilder() ? algorithm->getSelectedBuilder()->objectName() : QString();
+    runningJob.previousComplexity = algorithm->getSelectedComplexityName();
+    runningJob.previousCacheMode = algorithm->getSelectedCacheMode();
+
+    QVariantHash properties = job.properties;
+    if(runningJob.core >= 0)
+    {
+        properties["pinnedCore"] = runningJob.core;
+    }
+
+    if(!readProperties(algorithm, properties, runningJob.previousProperties, outInfo))
+    {
+        return false;
+    }
+
+    if(!job.builderName.isEmpty() && !algorithm->selectBuilder(job.builderName))
+    {
+        outInfo = AlgorithmTexts::UnknownJobBuilder + job.builderName;
+        return false;
+    }
+
+    DataStructureBuilder* builder = algorithm->getSelectedBuilder();
+    if(builder && !readProperties(builder, job.builderProperties, runningJob.previousBuilderProperties, outInfo))
+    {
+        return false;
+    }
+
+    if(!job.cacheMode.isEmpty() && !algorithm->selectCacheMode(job.cacheMode))
+    {
+        outInfo = AlgorithmTexts::UnknownJobCacheMode + job.cacheMode;
+        return false;
+    }
+
+    if(!job.complexity.isEmpty())
+    {
+        algorithm->selectComplexity(job.complexity);
+    }
+
+    writeProperties(algorithm, properties);
+    if(builder)
+    {
+        writeProperties(builder, job.builderProperties);
+    }
+
+    return algorithm->canRunBenchmark(outInfo);
+}
+
+void BenchmarkJobQueue::restoreJob(const RunningJob &runningJob) const
+{
+    Algorithm* algorithm = runningJob.job.algorithm;
+
+    // only what setUpJob read was changed, so the previous values cover everything the job touched
+    writeProperties(algorithm, runningJob.previousProperties);
+
+    DataStructureBuilder* builder = algorithm->getSelectedBuilder();
+    if(builder)
+    {
+        writeProperties(builder, runningJob.previousBuilderProperties);
+    }
+
+    if(!runningJob.previousBuilderName.isEmpty())
+    {
+        algorithm->selectBuilder(runningJob.previousBuilderName);
+    }
+
+    algorithm->selectCacheMode(runningJob.previousCacheMode);
+    algorithm->selectComplexity(runningJob.previousComplexity);
+}
+
+void BenchmarkJobQueue::onJobResult(Algorithm *algorithm, const AlgorithmBenchmarkResult &resultData)
+{
+    auto it = runningJobs.find(algorithm);
+    if(it == runningJobs.end())
+    {
+        return;
+    }
+
+    AlgorithmBenchmarkResult storedResult = resultData;
+
+    QString outInfo;
+    if(!BenchmarkResultsStore().appendRun(storedResult, outInfo))
+    {
+        it->errors.append(outInfo);
+    }
+}
+
+void BenchmarkJobQueue::onJobRunEnded(Algorithm *algorithm)
+{
+    auto it = runningJobs.find(algorithm);
+    if(it == runningJobs.end())
+    {
+        return;
+    }
+
+    const RunningJob runningJob = it.value();
+    runningJobs.erase(it);
+
+    disconnect(runningJob.resultConnection);
+    restoreJob(runningJob);
+
+    freeCores.append(runningJob.core);
+
+    finishJob(runningJob, runningJob.errors.join("\n"));
+
+    startNextJobs();
+}
+
+void BenchmarkJobQueue::finishJob(const RunningJob &runningJob, const QString &info)
+{
+    finishedJobsNum++;
+    if(!info.isEmpty())
+    {
+        failedJobsNum++;
+    }
+
+    emit jobFinished(runningJob.job, info);
+}
@@ -0,0 +1,105 @@
+#ifndef BENCHMARK_JOB_QUEUE_H
+#define BENCHMARK_JOB_QUEUE_H
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QThreadPool>
+#include <QVariantHash>
+
+class Algorithm;
+struct AlgorithmBenchmarkResult;
+
+namespace BenchmarkJobSchedules
+{
+    inline const QString Sequential = "sequential"; // one job after another on a single worker
+    inline const QString Parallel = "parallel"; // one worker per given core, each job pinned to the core of its worker
+
+    inline const QStringList All = {Sequential, Parallel};
+}
+
+// One benchmark of a suite, empty fields keep what is selected in the algorithm
+struct BenchmarkJob
+{
+    Algorithm* algorithm = nullptr;
+    QString builderName;
+    QString complexity;
+    QString cacheMode;
+    QVariantHash properties; // algorithm properties by name
+    QVariantHash builderProperties;
+    int priority = 0; // higher first, jobs of the same priority in the order they were added
+    bool runAlone = false; // waits until no other job runs and keeps the others waiting, always set for parallel algorithms
+
+    QString getDescription() const;
+};
+
+/**
+ * Runs benchmark jobs on its own workers, every result is appended to the results store as soon as it arrives.
+ * A job changes the algorithm only for its run, the previous builder, complexity, cache mode and properties are restored afterwards.
+ * An algorithm is a single runnable, so jobs of the same algorithm never run at the same time.
+ */
+class BenchmarkJobQueue : public QObject
+{
+    Q_OBJECT
+public:
+    explicit BenchmarkJobQueue(QObject* parent = nullptr);
+    ~BenchmarkJobQueue();
+
+    void addJob(const BenchmarkJob& job);
+
+    // workerCores is needed by the parallel schedule only, the sequential one pins its jobs when a core is given
+    bool start(const QString& schedule, const QList<int>& workerCores, QString& outInfo);
+
+    void stop();
+
+    bool isRunning() const;
+    qsizetype getPendingJobsNum() const;
+    qsizetype getRunningJobsNum() const;
+
+signals:
+    void jobStarted(const BenchmarkJob& job);
+
+    // info is empty when the job ran and all of its results were saved
+    void jobFinished(const BenchmarkJob& job, const QString& info);
+
+    void allJobsFinished(int jobsNum, int failedJobsNum);
+
+private:
+    struct RunningJob
+    {
+        BenchmarkJob job;
+        int core = -1;
+
+        QString previousBuilderName;
+        QString previousComplexity;
+        QString previousCacheMode;
+        QVariantHash previousProperties;
+        QVariantHash previousBuilderProperties;
+
+        QStringList errors;
+        QMetaObject::Connection resultConnection;
+    };
+
+    void startNextJobs();
+
+    bool setUpJob(RunningJob& runningJob, QString& outInfo) const;
+    void restoreJob(const RunningJob& runningJob) const;
+
+    void onJobResult(Algorithm* algorithm, const AlgorithmBenchmarkResult& resultData);
+    void onJobRunEnded(Algorithm* algorithm);
+
+    void finishJob(const RunningJob& runningJob, const QString& info);
+
+    QList<BenchmarkJob> pendingJobs;
+    QHash<Algorithm*, RunningJob> runningJobs;
+
+    bool running;
+    QList<int> freeCores; // -1 leaves the pinned core of the job's algorithm
+
+    int finishedJobsNum;
+    int failedJobsNum;
+
+    QThreadPool workerPool;
+};
+
+#endif // BENCHMARK_JOB_QUEUE_H
@@ -0,0 +1,111 @@
+#include "benchmark_partial_results.h"
+#include "complexity_analysis.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+BenchmarkPartialResultsQueue::~BenchmarkPartialResultsQueue()
+{
+    takeAll();
+}
+
+void BenchmarkPartialResultsQueue::push(BenchmarkPartialResults &&partialResults)
+{
+    Node* node = new Node{std::move(partialResults), head.load(std::memory_order_relaxed)};
+    while(!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+}
+
+QList<BenchmarkPartialResults> BenchmarkPartialResultsQueue::takeAll()
+{
+    Node* node = head.exchange(nullptr, std::memory_order_acquire);
+
+    QList<BenchmarkPartialResults> partialResultsList;
+    while(node)
+    {
+        partialResultsList.append(std::move(node->partialResults));
+
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+
+    std::reverse(partialResultsList.begin(), partialResultsList.end());
+
+    return partialResultsList;
+}
+
+void BenchmarkProgress::addPartialResults(const BenchmarkPartialResults &partialResults)
+{
+    const int firstIteration = partialResults.completedIterations - partialResults.pointWallTimes.size() + 1;
+    for(int i = 0; i < partialResults.pointWallTimes.size(); ++i)
+    {
+        iterations.append(firstIteration + i);
+        wallTimes.append(partialResults.pointWallTimes[i]);
+    }
+
+    completedIterations = partialResults.completedIterations;
+    iterationsNumber = partialResults.iterationsNumber;
+}
+
+int BenchmarkProgress::getCompletedIterations() const
+{
+    return completedIterations;
+}
+
+int BenchmarkProgress::getIterationsNumber() const
+{
+    return iterationsNumber;
+}
+
+qreal BenchmarkProgress::estimateRemainingMs() const
+{
+    if(iterations.size() < 2)
+    {
+        return -1.0;
+    }
+
+    const EmpiricalExponent empiricalExponent = EmpiricalExponent::estimate(iterations, wallTimes);
+    const qreal exponent = empiricalExponent.isValid ? std::clamp(empiricalExponent.exponent, 0.0, 4.0) : 1.0;
+
+    qreal modelSum = 0.0;
+    qreal timesSum = 0.0;
+    for(int i = 0; i < iterations.size(); ++i)
+    {
+        modelSum += std::pow(iterations[i], exponent);
+        timesSum += wallTimes[i];
+    }
+
+    if(modelSum <= 0.0)
+    {
+        return -1.0;
+    }
+
+    const qreal constantFactor = timesSum / modelSum;
+
+    qreal remainingModelSum = 0.0;
+    for(int iteration = completedIterations + 1; iteration <= iterationsNumber; ++iteration)
+    {
+        remainingModelSum += std::pow(static_cast<qreal>(iteration), exponent);
+    }
+
+    return constantFactor * remainingModelSum;
+}
+
+QString BenchmarkProgress::getText() const
+{
+    QString text = QString::number(completedIterations) + " / " + QString::number(iterationsNumber) + " points";
+
+    const qreal remainingMs = estimateRemainingMs();
+    if(remainingMs >= 0.0)
+    {
+        const qint64 remainingSeconds = static_cast<qint64>(remainingMs / 1000.0);
+        text.append(", ETA " + QString("%1:%2:%3").arg(remainingSeconds / 3600)
+                                   .arg(remainingSeconds / 60 % 60, 2, 10, QChar('0'))
+                                   .arg(remainingSeconds % 60, 2, 10, QChar('0')));
+    }
+
+    return text;
+}
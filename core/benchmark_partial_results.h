@@ -0,0 +1,82 @@
+#ifndef BENCHMARK_PARTIAL_RESULTS_H
+#define BENCHMARK_PARTIAL_RESULTS_H
+
+#include <QList>
+#include <QPointF>
+#include <QString>
+
+#include <atomic>
+
+// Batch of points finished by a running benchmark, points belong to consecutive iterations ending at completedIterations
+struct BenchmarkPartialResults
+{
+    QList<QPointF> points;
+    QList<qreal> pointWallTimes; // milliseconds spent on each point, graph building included
+    int completedIterations = 0;
+    int iterationsNumber = 0;
+
+    bool isEmpty() const
+    {
+        return points.isEmpty();
+    }
+
+    void clear()
+    {
+        points.clear();
+        pointWallTimes.clear();
+    }
+};
+
+/**
+ * Lock-free queue from the benchmark thread to the GUI. Producers push with a compare-and-swap on the head,
+ * the consumer swaps the whole list out at once, so there is no ABA problem and no one ever waits.
+ */
+class BenchmarkPartialResultsQueue
+{
+public:
+    BenchmarkPartialResultsQueue() = default;
+    ~BenchmarkPartialResultsQueue();
+
+    BenchmarkPartialResultsQueue(const BenchmarkPartialResultsQueue&) = delete;
+    BenchmarkPartialResultsQueue& operator=(const BenchmarkPartialResultsQueue&) = delete;
+
+    void push(BenchmarkPartialResults&& partialResults);
+
+    QList<BenchmarkPartialResults> takeAll();
+
+private:
+    struct Node
+    {
+        BenchmarkPartialResults partialResults;
+        Node* next;
+    };
+
+    std::atomic<Node*> head{nullptr};
+};
+
+// Progress of a running benchmark with the remaining time extrapolated from the size schedule
+class BenchmarkProgress
+{
+public:
+    void addPartialResults(const BenchmarkPartialResults& partialResults);
+
+    int getCompletedIterations() const;
+    int getIterationsNumber() const;
+
+    /**
+     * Point times are fitted as c * iteration^k (log-log regression), the remaining iterations
+     * are summed from that model. Returns a negative value while there are too few points.
+     */
+    qreal estimateRemainingMs() const;
+
+    QString getText() const;
+
+private:
+    QList<qreal> iterations;
+    QList<qreal> wallTimes;
+
+    int completedIterations = 0;
+    int iterationsNumber = 0;
+};
+
+#endif // BENCHMARK_PARTIAL_RESULTS_H
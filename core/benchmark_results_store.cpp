@@ -0,0 +1,206 @@
+#include "benchmark_results_store.h"
+#include "benchmark_timers.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QUuid>
+
+BenchmarkResultsStore::BenchmarkResultsStore(const QString &inFilePath)
+    : filePath(inFilePath)
+{
+
+}
+
+bool BenchmarkResultsStore::appendRun(AlgorithmBenchmarkResult &resultData, QString &outInfo) const
+{
+    if(resultData.runInfo.runId.isEmpty())
+    {
+        resultData.runInfo.runId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    }
+
+    QFile storeFile(filePath);
+    if(!storeFile.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        outInfo = "Cannot open " + filePath + " for writing: " + storeFile.errorString();
+        return false;
+    }
+
+    QByteArray line = QJsonDocument(resultToJsonObject(resultData)).toJson(QJsonDocument::Compact);
+    line.append('\n');
+
+    if(storeFile.write(line) != line.size())
+    {
+        outInfo = "Cannot write to " + filePath + ": " + storeFile.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+bool BenchmarkResultsStore::loadRuns(QList<AlgorithmBenchmarkResult> &outRuns, QString &outInfo) const
+{
+    QFile storeFile(filePath);
+    if(!storeFile.exists())
+    {
+        outInfo = "No results stored yet in " + filePath + ".";
+        return false;
+    }
+
+    if(!storeFile.open(QIODevice::ReadOnly))
+    {
+        outInfo = "Cannot open " + filePath + ": " + storeFile.errorString();
+        return false;
+    }
+
+    while(!storeFile.atEnd())
+    {
+        const QByteArray line = storeFile.readLine().trimmed();
+        if(line.isEmpty())
+        {
+            continue;
+        }
+
+        const QJsonDocument jsonDoc = QJsonDocument::fromJson(line);
+        if(jsonDoc.isObject())
+        {
+            outRuns.append(resultFromJsonObject(jsonDoc.object()));
+        }
+    }
+
+    return true;
+}
+
+const QString &BenchmarkResultsStore::getFilePath() const
+{
+    return filePath;
+}
+
+QJsonObject BenchmarkResultsStore::resultToJsonObject(const AlgorithmBenchmarkResult &resultData)
+{
+    const qsizetype pointsNum = resultData.mainSeries.size();
+    const bool hasStatistics = resultData.mainSeriesStatistics.size() == pointsNum;
+    const bool hasInputs = resultData.mainSeriesInputs.size() == pointsNum;
+
+    QJsonArray pointsAsJsonArray;
+    for(qsizetype i = 0; i < pointsNum; ++i)
+    {
+        QJsonObject pointAsJsonObject;
+        pointAsJsonObject["x"] = resultData.mainSeries[i].x();
+        pointAsJsonObject["y"] = resultData.mainSeries[i].y();
+
+        if(hasStatistics)
+        {
+            pointAsJsonObject["statistics"] = resultData.mainSeriesStatistics[i].toJsonObject();
+        }
+
+        if(hasInputs)
+        {
+            const ComplexityVariables& pointInput = resultData.mainSeriesInputs[i];
+            pointAsJsonObject["I"] = pointInput.iteration;
+            pointAsJsonObject["V"] = pointInput.nodesNum;
+            pointAsJsonObject["E"] = pointInput.edgesNum;
+            pointAsJsonObject["Wmin"] = pointInput.minWeight;
+            pointAsJsonObject["Wmax"] = pointInput.maxWeight;
+        }
+
+        pointsAsJsonArray.append(pointAsJsonObject);
+    }
+
+    QJsonObject subSeriesAsJsonObject;
+    for(auto it = resultData.subSeriesNameToSubSeriesData.constBegin(); it != resultData.subSeriesNameToSubSeriesData.constEnd(); ++it)
+    {
+        const SubSeriesData& subSeries = it.value();
+
+        QJsonArray subSeriesPointsAsJsonArray;
+        for(const QPointF& point : subSeries.points)
+        {
+            subSeriesPointsAsJsonArray.append(QJsonArray{point.x(), point.y()});
+        }
+
+        QJsonObject subSeriesDataAsJsonObject;
+        subSeriesDataAsJsonObject["color"] = subSeries.color.name();
+        subSeriesDataAsJsonObject["aggregationMode"] = static_cast<int>(subSeries.aggregationMode);
+        subSeriesDataAsJsonObject["isCounter"] = subSeries.isCounter;
+        subSeriesDataAsJsonObject["points"] = subSeriesPointsAsJsonArray;
+
+        subSeriesAsJsonObject[it.key()] = subSeriesDataAsJsonObject;
+    }
+
+    QJsonArray callTreesAsJsonArray;
+    for(const BenchmarkCallTree& callTree : resultData.callTrees)
+    {
+        callTreesAsJsonArray.append(callTree.toJsonObject());
+    }
+
+    QJsonObject resultAsJsonObject;
+    resultAsJsonObject["runInfo"] = resultData.runInfo.toJsonObject();
+    resultAsJsonObject["info"] = resultData.toolTipInfo;
+    resultAsJsonObject["points"] = pointsAsJsonArray;
+    resultAsJsonObject["subSeries"] = subSeriesAsJsonObject;
+    resultAsJsonObject["callTrees"] = callTreesAsJsonArray;
+
+    if(!resultData.complexityAnalysis.isEmpty())
+    {
+        resultAsJsonObject["complexityAnalysis"] = resultData.complexityAnalysis.toJsonObject();
+    }
+
+    return resultAsJsonObject;
+}
+
+AlgorithmBenchmarkResult BenchmarkResultsStore::resultFromJsonObject(const QJsonObject &jsonObject)
+{
+    AlgorithmBenchmarkResult resultData;
+    resultData.runInfo = BenchmarkRunInfo::fromJsonObject(jsonObject["runInfo"].toObject());
+    resultData.toolTipInfo = jsonObject["info"].toString();
+
+    const QJsonArray pointsAsJsonArray = jsonObject["points"].toArray();
+    for(const QJsonValue& pointAsJsonValue : pointsAsJsonArray)
+    {
+        const QJsonObject pointAsJsonObject = pointAsJsonValue.toObject();
+        resultData.mainSeries.append(QPointF(pointAsJsonObject["x"].toDouble(), pointAsJsonObject["y"].toDouble()));
+
+        if(pointAsJsonObject.contains("statistics"))
+        {
+            resultData.mainSeriesStatistics.append(BenchmarkStatistics::fromJsonObject(pointAsJsonObject["statistics"].toObject()));
+        }
+
+        if(pointAsJsonObject.contains("V"))
+        {
+            ComplexityVariables pointInput;
+            pointInput.iteration = pointAsJsonObject["I"].toDouble();
+            pointInput.nodesNum = pointAsJsonObject["V"].toDouble();
+            pointInput.edgesNum = pointAsJsonObject["E"].toDouble();
+            pointInput.minWeight = pointAsJsonObject["Wmin"].toDouble();
+            pointInput.maxWeight = pointAsJsonObject["Wmax"].toDouble();
+
+            resultData.mainSeriesInputs.append(pointInput);
+        }
+    }
+
+    const QJsonObject subSeriesAsJsonObject = jsonObject["subSeries"].toObject();
+    for(auto it = subSeriesAsJsonObject.constBegin(); it != subSeriesAsJsonObject.constEnd(); ++it)
+    {
+        const QJsonObject subSeriesDataAsJsonObject = it.value().toObject();
+
+        SubSeriesData& subSeries = resultData[it.key()];
+        subSeries.color = QColor(subSeriesDataAsJsonObject["color"].toString());
+        subSeries.aggregationMode = static_cast<AggregationMode>(subSeriesDataAsJsonObject["aggregationMode"].toInt());
+        subSeries.isCounter = subSeriesDataAsJsonObject["isCounter"].toBool();
+
+        const QJsonArray subSeriesPointsAsJsonArray = subSeriesDataAsJsonObject["points"].toArray();
+        for(const QJsonValue& pointAsJsonValue : subSeriesPointsAsJsonArray)
+        {
+            const QJsonArray pointAsJsonArray = pointAsJsonValue.toArray();
+            subSeries.points.append(QPointF(pointAsJsonArray[0].toDouble(), pointAsJsonArray[1].toDouble()));
+        }
+    }
+
+    const QJsonArray callTreesAsJsonArray = jsonObject["callTrees"].toArray();
+    for(const QJsonValue& callTreeAsJsonValue : callTreesAsJsonArray)
+    {
+        resultData.callTrees.append(BenchmarkCallTree::fromJsonObject(callTreeAsJsonValue.toObject()));
+    }
+
+    return resultData;
+}
@@ -0,0 +1,36 @@
+#ifndef BENCHMARK_RESULTS_STORE_H
+#define BENCHMARK_RESULTS_STORE_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+struct AlgorithmBenchmarkResult;
+
+/**
+ * Append-only file of benchmark runs, one compact JSON object per line.
+ * Runs are never rewritten, so older results stay available as baselines. A broken line
+ * (for example from an interrupted write) is skipped on load instead of failing the whole store.
+ */
+class BenchmarkResultsStore
+{
+public:
+    static inline const QString DefaultFilePath = "benchmark results.jsonl";
+
+    explicit BenchmarkResultsStore(const QString& inFilePath = DefaultFilePath);
+
+    // assigns a run id when the result has none yet
+    bool appendRun(AlgorithmBenchmarkResult& resultData, QString& outInfo) const;
+
+    bool loadRuns(QList<AlgorithmBenchmarkResult>& outRuns, QString& outInfo) const;
+
+    const QString& getFilePath() const;
+
+    static QJsonObject resultToJsonObject(const AlgorithmBenchmarkResult& resultData);
+    static AlgorithmBenchmarkResult resultFromJsonObject(const QJsonObject& jsonObject);
+
+private:
+    QString filePath;
+};
+
+#endif // BENCHMARK_RESULTS_STORE_H
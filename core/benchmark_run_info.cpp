@@ -0,0 +1,75 @@
+#include "benchmark_run_info.h"
+#include "benchmark_timers.h"
+
+#include <QMetaProperty>
+#include <QObject>
+#include <QSysInfo>
+
+#ifndef ALGORITHMS_GIT_REVISION
+#define ALGORITHMS_GIT_REVISION "unknown"
+#endif
+
+void BenchmarkRunInfo::setCurrentEnvironment()
+{
+    gitRevision = ALGORITHMS_GIT_REVISION;
+    host = QSysInfo::machineHostName();
+    clockBackend = BenchmarkTimerRecorder::ClockBackend;
+}
+
+QString BenchmarkRunInfo::getDescription() const
+{
+    return startTime + " | " + algorithmName + " | " + builderName + " | " + gitRevision + " | " + host;
+}
+
+QJsonObject BenchmarkRunInfo::toJsonObject() const
+{
+    QJsonObject runInfoAsJsonObject;
+    runInfoAsJsonObject["runId"] = runId;
+    runInfoAsJsonObject["algorithm"] = algorithmName;
+    runInfoAsJsonObject["builder"] = builderName;
+    runInfoAsJsonObject["algorithmProperties"] = algorithmProperties;
+    runInfoAsJsonObject["builderProperties"] = builderProperties;
+    runInfoAsJsonObject["gitRevision"] = gitRevision;
+    runInfoAsJsonObject["host"] = host;
+    runInfoAsJsonObject["clockBackend"] = clockBackend;
+    runInfoAsJsonObject["environment"] = environment;
+    runInfoAsJsonObject["startTime"] = startTime;
+    runInfoAsJsonObject["endTime"] = endTime;
+
+    return runInfoAsJsonObject;
+}
+
+BenchmarkRunInfo BenchmarkRunInfo::fromJsonObject(const QJsonObject &jsonObject)
+{
+    BenchmarkRunInfo runInfo;
+    runInfo.runId = jsonObject["runId"].toString();
+    runInfo.algorithmName = jsonObject["algorithm"].toString();
+    runInfo.builderName = jsonObject["builder"].toString();
+    runInfo.algorithmProperties = jsonObject["algorithmProperties"].toObject();
+    runInfo.builderProperties = jsonObject["builderProperties"].toObject();
+    runInfo.gitRevision = jsonObject["gitRevision"].toString();
+    runInfo.host = jsonObject["host"].toString();
+    runInfo.clockBackend = jsonObject["clockBackend"].toString();
+    runInfo.environment = jsonObject["environment"].toObject();
+    runInfo.startTime = jsonObject["startTime"].toString();
+    runInfo.endTime = jsonObject["endTime"].toString();
+
+    return runInfo;
+}
+
+QJsonObject BenchmarkRunInfo::propertiesToJsonObject(const QObject *object)
+{
+    QJsonObject propertiesAsJsonObject;
+
+    const QMetaObject* metaObject = object->metaObject();
+    for (int i = 0; i < metaObject->propertyCount(); ++i)
+    {
+        const QMetaProperty metaProperty = metaObject->property(i);
+        if(QString(metaProperty.name()) != "objectName")
+        {
+            propertiesAsJsonObject[metaProperty.name()] = QJsonValue::fromVariant(metaProperty.read(object));
+        }
+    }
+
+    return propertiesAsJsonObject;
+}
@@ -0,0 +1,34 @@
+#ifndef BENCHMARK_RUN_INFO_H
+#define BENCHMARK_RUN_INFO_H
+
+#include <QJsonObject>
+#include <QString>
+
+class QObject;
+
+// Everything needed to tell which code, input and machine produced a stored benchmark run
+struct BenchmarkRunInfo
+{
+    QString runId;
+    QString algorithmName;
+    QString builderName;
+    QJsonObject algorithmProperties;
+    QJsonObject builderProperties;
+    QString gitRevision;
+    QString host;
+    QString clockBackend;
+    QJsonObject environment; // processor, frequencies and power scheme of the measuring core
+    QString startTime;
+    QString endTime;
+
+    void setCurrentEnvironment();
+
+    QString getDescription() const;
+
+    QJsonObject toJsonObject() const;
+    static BenchmarkRunInfo fromJsonObject(const QJsonObject& jsonObject);
+
+    static QJsonObject propertiesToJsonObject(const QObject* object);
+};
+
+#endif // BENCHMARK_RUN_INFO_H
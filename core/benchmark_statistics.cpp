@@ -0,0 +1,116 @@
+#include "benchmark_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace BenchmarkStatisticsUtils
+{
+    qreal percentile(const QList<qreal>& sortedSamples, qreal percent)
+    {
+        if(sortedSamples.isEmpty())
+        {
+            return 0.0;
+        }
+
+        const qreal rank = percent / 100.0 * (sortedSamples.size() - 1);
+        const qsizetype lowerIndex = static_cast<qsizetype>(std::floor(rank));
+        const qsizetype upperIndex = std::min(lowerIndex + 1, sortedSamples.size() - 1);
+        const qreal fraction = rank - lowerIndex;
+
+        return sortedSamples[lowerIndex] + (sortedSamples[upperIndex] - sortedSamples[lowerIndex]) * fraction;
+    }
+
+    LinearRegressionResult linearRegression(const QList<qreal>& xs, const QList<qreal>& ys)
+    {
+        LinearRegressionResult result;
+
+        const qsizetype pointsNum = std::min(xs.size(), ys.size());
+        if(pointsNum < 2)
+        {
+            return result;
+        }
+
+        const qreal meanX = std::accumulate(xs.begin(), xs.begin() + pointsNum, 0.0) / pointsNum;
+        const qreal meanY = std::accumulate(ys.begin(), ys.begin() + pointsNum, 0.0) / pointsNum;
+
+        qreal covarianceXY = 0.0;
+        qreal varianceX = 0.0;
+        qreal varianceY = 0.0;
+
+        for(qsizetype i = 0; i < pointsNum; ++i)
+        {
+            covarianceXY += (xs[i] - meanX) * (ys[i] - meanY);
+            varianceX += (xs[i] - meanX) * (xs[i] - meanX);
+            varianceY += (ys[i] - meanY) * (ys[i] - meanY);
+        }
+
+        if(varianceX == 0.0)
+        {
+            return result;
+        }
+
+        result.isValid = true;
+        result.slope = covarianceXY / varianceX;
+        result.intercept = meanY - result.slope * meanX;
+        result.rSquared = varianceY == 0.0 ? 1.0 : (covarianceXY * covarianceXY) / (varianceX * varianceY);
+
+        return result;
+    }
+}
+
+BenchmarkStatistics BenchmarkStatistics::fromSamples(QList<qreal> samples)
+{
+    BenchmarkStatistics statistics;
+    if(samples.isEmpty())
+    {
+        return statistics;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    statistics.samplesNum = samples.size();
+    statistics.min = samples.first();
+    statistics.median = BenchmarkStatisticsUtils::percentile(samples, 50.0);
+    statistics.p90 = BenchmarkStatisticsUtils::percentile(samples, 90.0);
+    statistics.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+
+    if(samples.size() > 1)
+    {
+        qreal squaredDeviations = 0.0;
+        for(qreal sample : samples)
+        {
+            squaredDeviations += (sample - statistics.mean) * (sample - statistics.mean);
+        }
+
+        statistics.stddev = std::sqrt(squaredDeviations / (samples.size() - 1));
+    }
+
+    return statistics;
+}
+
+QJsonObject BenchmarkStatistics::toJsonObject() const
+{
+    QJsonObject statisticsAsJsonObject;
+    statisticsAsJsonObject["min"] = min;
+    statisticsAsJsonObject["median"] = median;
+    statisticsAsJsonObject["mean"] = mean;
+    statisticsAsJsonObject["p90"] = p90;
+    statisticsAsJsonObject["stddev"] = stddev;
+    statisticsAsJsonObject["samplesNum"] = samplesNum;
+
+    return statisticsAsJsonObject;
+}
+
+BenchmarkStatistics BenchmarkStatistics::fromJsonObject(const QJsonObject &jsonObject)
+{
+    BenchmarkStatistics statistics;
+    statistics.min = jsonObject["min"].toDouble();
+    statistics.median = jsonObject["median"].toDouble();
+    statistics.mean = jsonObject["mean"].toDouble();
+    statistics.p90 = jsonObject["p90"].toDouble();
+    statistics.stddev = jsonObject["stddev"].toDouble();
+    statistics.samplesNum = jsonObject["samplesNum"].toInt();
+
+    return statistics;
+}
@@ -0,0 +1,40 @@
+#ifndef BENCHMARK_STATISTICS_H
+#define BENCHMARK_STATISTICS_H
+
+#include <QJsonObject>
+#include <QList>
+
+// Robust summary of the repeated measurements taken for a single benchmark point
+struct BenchmarkStatistics
+{
+    qreal min = 0.0;
+    qreal median = 0.0;
+    qreal mean = 0.0;
+    qreal p90 = 0.0;
+    qreal stddev = 0.0;
+    int samplesNum = 0;
+
+    static BenchmarkStatistics fromSamples(QList<qreal> samples);
+
+    QJsonObject toJsonObject() const;
+    static BenchmarkStatistics fromJsonObject(const QJsonObject& jsonObject);
+};
+
+struct LinearRegressionResult
+{
+    bool isValid = false;
+    qreal slope = 0.0;
+    qreal intercept = 0.0;
+    qreal rSquared = 0.0;
+};
+
+namespace BenchmarkStatisticsUtils
+{
+    /** samples have to be sorted, linear interpolation between closest ranks is used */
+    qreal percentile(const QList<qreal>& sortedSamples, qreal percent);
+
+    /** ordinary least squares fit of y = slope * x + intercept */
+    LinearRegressionResult linearRegression(const QList<qreal>& xs, const QList<qreal>& ys);
+}
+
+#endif // BENCHMARK_STATISTICS_H
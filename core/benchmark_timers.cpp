@@ -1,91 +1,340 @@
 #include "benchmark_timers.h"
-#include "algorithm.h"
 
-AlgorithmBenchmarkTimerManager &AlgorithmBenchmarkTimerManager::getTimerManager()
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+BenchmarkTimerRecorder &BenchmarkTimerRecorder::getThreadRecorder()
+{
+    static thread_local BenchmarkTimerRecorder timerRecorder;
+    return timerRecorder;
+}
+
+BenchmarkTimerRecorder::BenchmarkTimerRecorder()
+    : events(new BenchmarkTimerEvent[EventsCapacity])
+    , firstEvent(0)
+    , eventsNum(0)
+    , callTreeNodes(new CallTreeNode[CallTreeNodesCapacity])
+    , accumulators(new TimerAccumulator[CallTreeNodesCapacity])
+    , callTreeNodesNum(0)
+    , currentTimer(nullptr)
+    , iteration(0)
+    , recording(false)
+    , invocationsNum(0)
+    , takenInvocationsNum(0)
+    , timersWorkCycles(0)
 {
-    static AlgorithmBenchmarkTimerManager timerManager;
-    return timerManager;
+    reset();
 }
 
-ULONG64 AlgorithmBenchmarkTimerManager::takeTimersWorkCycles()
+void BenchmarkTimerRecorder::reset()
 {
-    const ULONG64 cycles = timersWorkCycles;
+    firstEvent = 0;
+    eventsNum = 0;
+
+    callTreeNodes[RootNode] = CallTreeNode{nullptr, -1, -1, -1};
+    accumulators[RootNode] = TimerAccumulator();
+    callTreeNodesNum = 1;
+    currentTimer = nullptr;
+
+    recording = false;
+    invocationsNum = 0;
+    takenInvocationsNum = 0;
     timersWorkCycles = 0;
-    return cycles;
+
+    for(BenchmarkCounter* counter : std::as_const(counters))
+    {
+        counter->recordedValue = 0;
+    }
+}
+
+void BenchmarkTimerRecorder::startRecording(int inIteration)
+{
+    iteration = static_cast<quint32>(inIteration);
+    recording = true;
+
+    for(BenchmarkCounter* counter : std::as_const(counters))
+    {
+        counter->valueAtRecordingStart = counter->value;
+    }
+}
+
+void BenchmarkTimerRecorder::stopRecording()
+{
+    if(!recording)
+    {
+        return;
+    }
+
+    recording = false;
+
+    for(BenchmarkCounter* counter : std::as_const(counters))
+    {
+        counter->recordedValue += counter->value - counter->valueAtRecordingStart;
+    }
+}
+
+void BenchmarkTimerRecorder::registerCounter(BenchmarkCounter *counter)
+{
+    counter->valueAtRecordingStart = counter->value;
+    counters.append(counter);
+}
+
+void BenchmarkTimerRecorder::unregisterCounter(BenchmarkCounter *counter)
+{
+    counters.removeOne(counter);
 }
 
-void AlgorithmBenchmarkTimerManager::clear(const Algorithm* algorithm)
+ULONG64 BenchmarkTimerRecorder::takeTimersWorkCycles()
 {
-    algorithmToResultData[algorithm].clear();
+    const ULONG64 cycles = timersWorkCycles + (invocationsNum - takenInvocationsNum) * overhead.totalCycles;
+    takenInvocationsNum = invocationsNum;
     timersWorkCycles = 0;
+    return cycles;
 }
 
-BenchmarkScopedTimer::BenchmarkScopedTimer(const Algorithm* inAlgorithm, const QString &inName, const QColor &inColor, AggregationMode inAggregationMode)
-    : algorithm(inAlgorithm)
-    , name(inName)
-    , color(inColor)
-    , aggregationMode(inAggregationMode)
+void BenchmarkTimerRecorder::calibrateOverhead()
 {
-#ifdef QT_DEBUG
-    if(!algorithm->getIsDebugRun())
-#endif
+    static constexpr BenchmarkTimerSite calibrationSite{"timer calibration", Qt::gray, AggregationMode::Sum};
+
+    constexpr int batchesNum = 20;
+    constexpr int invocationsPerBatch = 1000; // fits in the ring, so nothing is folded while measuring
+
+    BenchmarkTimerRecorder& recorder = getThreadRecorder();
+
+    // raw cycles are needed, so nothing may be subtracted during calibration
+    overhead = BenchmarkTimerOverhead();
+
+    ULONG64 minInnerCycles = std::numeric_limits<ULONG64>::max();
+    ULONG64 minTotalCycles = std::numeric_limits<ULONG64>::max();
+
+    // the cheapest batch is the one least disturbed by interrupts and context switches
+    for(int batch = 0; batch < batchesNum; ++batch)
     {
-        AlgorithmBenchmarkTimerManager::getTimerManager().algorithmToResultData[algorithm][name].color = color;
+        recorder.reset();
+        recorder.startRecording(0);
 
+        ULONG64 start;
         QueryThreadCycleTime(GetCurrentThread(), &start);
+
+        for(int i = 0; i < invocationsPerBatch; ++i)
+        {
+            BenchmarkScopedTimer scopedTimer(&calibrationSite);
+        }
+
+        ULONG64 end;
+        QueryThreadCycleTime(GetCurrentThread(), &end);
+
+        recorder.stopRecording();
+
+        ULONG64 innerCyclesSum = 0;
+        for(int i = 0; i < recorder.eventsNum; ++i)
+        {
+            innerCyclesSum += recorder.events[i].cycles;
+        }
+
+        minInnerCycles = std::min(minInnerCycles, innerCyclesSum / invocationsPerBatch);
+        minTotalCycles = std::min(minTotalCycles, (end - start) / invocationsPerBatch);
     }
+
+    recorder.reset();
+
+    overhead.innerCycles = minInnerCycles;
+    overhead.totalCycles = std::max(minTotalCycles, minInnerCycles);
+}
+
+const BenchmarkTimerOverhead &BenchmarkTimerRecorder::getOverhead()
+{
+    return overhead;
 }
 
-BenchmarkScopedTimer::~BenchmarkScopedTimer()
+void BenchmarkTimerRecorder::flush(AlgorithmBenchmarkResult &resultData, qreal x, int runsNum)
 {
-#ifdef QT_DEBUG
-    if(!algorithm->getIsDebugRun())
-#endif
+    foldEvents();
+
+    const qreal runs = std::max(runsNum, 1);
+
+    BenchmarkCallTree callTree;
+    callTree.x = x;
+
+    // nodes are added after their parents, so a parent is always in the tree before its children
+    QList<int> nodeToTreeIndex(callTreeNodesNum, -1);
+
+    for(int node = RootNode + 1; node < callTreeNodesNum; ++node)
     {
-        QueryThreadCycleTime(GetCurrentThread(), &end);
+        TimerAccumulator& accumulator = accumulators[node];
+        if(!accumulator.hasValue)
+        {
+            continue;
+        }
+
+        const BenchmarkTimerSite* site = callTreeNodes[node].site;
+        const QString path = getNodePath(node);
+
+        SubSeriesData& subSeriesData = resultData[path];
+        subSeriesData.color = site->color;
+        subSeriesData.aggregationMode = site->aggregationMode;
 
-        ULONG64 workStart;
-        QueryThreadCycleTime(GetCurrentThread(), &workStart);
+        qreal y = accumulator.value;
+        if(site->aggregationMode == AggregationMode::Sum)
+        {
+            y /= runs;
+        }
+
+        subSeriesData.points.append(QPointF(x, y));
+
+        BenchmarkCallTreeNode callTreeNode;
+        callTreeNode.name = QString::fromLatin1(site->name);
+        callTreeNode.parent = nodeToTreeIndex[callTreeNodes[node].parent];
+        callTreeNode.totalCycles = accumulator.totalCycles / runs;
+        callTreeNode.selfCycles = accumulator.selfCycles / runs;
+        callTreeNode.callsNum = accumulator.callsNum / runs;
 
-        auto& timerManager = AlgorithmBenchmarkTimerManager::getTimerManager();
-        auto& resultData = timerManager.algorithmToResultData[algorithm][name];
+        nodeToTreeIndex[node] = callTree.nodes.size();
+        callTree.nodes.append(callTreeNode);
+
+        accumulator = TimerAccumulator();
+    }
+
+    if(!callTree.isEmpty())
+    {
+        resultData.callTrees.append(callTree);
+    }
 
-        const qreal elapsedCycles = (qreal)(end - start);
-        const qreal x = algorithm->calculateXForCurrentIteration();
+    // sites sharing a name, e.g. "edges scanned" in two helpers of one algorithm, add up to one point
+    QHash<QString, quint64> nameToRecordedValue;
+    QHash<QString, Qt::GlobalColor> nameToColor;
 
-        auto it = std::find_if(resultData.points.begin(), resultData.points.end(), [x] (const QPointF& point)
+    for(BenchmarkCounter* counter : std::as_const(counters))
+    {
+        if(counter->recordedValue == 0)
         {
-            return point.x() == x;
-        });
+            continue;
+        }
+
+        const QString name = QString::fromLatin1(counter->site->name);
+        nameToRecordedValue[name] += counter->recordedValue;
+        nameToColor.insert(name, counter->site->color);
 
-        if(it != resultData.points.end())
+        counter->recordedValue = 0;
+    }
+
+    for(auto it = nameToRecordedValue.constBegin(); it != nameToRecordedValue.constEnd(); ++it)
+    {
+        SubSeriesData& subSeriesData = resultData[it.key()];
+        subSeriesData.color = nameToColor[it.key()];
+        subSeriesData.isCounter = true;
+        subSeriesData.points.append(QPointF(x, it.value() / runs));
+    }
+}
+
+int BenchmarkTimerRecorder::findOrAddNode(int parentNode, const BenchmarkTimerSite *site)
+{
+    CallTreeNode& parent = callTreeNodes[parentNode];
+
+    for(int child = parent.firstChild; child >= 0; child = callTreeNodes[child].nextSibling)
+    {
+        if(callTreeNodes[child].site == site)
         {
-            switch (aggregationMode)
-            {
-            case AggregationMode::Sum:
-                it->ry() += elapsedCycles;
-                break;
-
-            case AggregationMode::Min:
-                it->ry() = std::min(it->y(), elapsedCycles);
-                break;
-
-            case AggregationMode::Max:
-                it->ry() = std::max(it->y(), elapsedCycles);
-                break;
-
-            default:
-                break;
-            }
+            return child;
         }
-        else
+    }
+
+    if(callTreeNodesNum == CallTreeNodesCapacity)
+    {
+        return -1;
+    }
+
+    const int node = callTreeNodesNum++;
+    callTreeNodes[node] = CallTreeNode{site, parentNode, -1, parent.firstChild};
+    accumulators[node] = TimerAccumulator();
+    parent.firstChild = node;
+
+    return node;
+}
+
+QString BenchmarkTimerRecorder::getNodePath(int node) const
+{
+    QString path = QString::fromLatin1(callTreeNodes[node].site->name);
+    for(int parent = callTreeNodes[node].parent; parent != RootNode; parent = callTreeNodes[parent].parent)
+    {
+        path.prepend(QString::fromLatin1(callTreeNodes[parent].site->name) + " / ");
+    }
+
+    return path;
+}
+
+void BenchmarkTimerRecorder::foldEvents()
+{
+    if(eventsNum == 0)
+    {
+        return;
+    }
+
+    ULONG64 foldStart;
+    QueryThreadCycleTime(GetCurrentThread(), &foldStart);
+
+    for(int i = 0; i < eventsNum; ++i)
+    {
+        const BenchmarkTimerEvent& event = events[(firstEvent + i) % EventsCapacity];
+        if(event.iteration != iteration)
+        {
+            continue;
+        }
+
+        TimerAccumulator& accumulator = accumulators[event.node];
+        const qreal cycles = static_cast<qreal>(event.cycles);
+
+        accumulator.totalCycles += cycles;
+        accumulator.selfCycles += static_cast<qreal>(event.selfCycles);
+        accumulator.callsNum++;
+
+        if(!accumulator.hasValue)
         {
-            resultData.points.append((QPointF{x, elapsedCycles}));
+            accumulator.hasValue = true;
+            accumulator.value = cycles;
+            continue;
         }
 
-        ULONG64 workEnd;
-        QueryThreadCycleTime(GetCurrentThread(), &workEnd);
+        switch (callTreeNodes[event.node].site->aggregationMode)
+        {
+        case AggregationMode::Sum:
+            accumulator.value += cycles;
+            break;
+
+        case AggregationMode::Min:
+            accumulator.value = std::min(accumulator.value, cycles);
+            break;
 
-        timerManager.timersWorkCycles += workEnd - workStart;
+        case AggregationMode::Max:
+            accumulator.value = std::max(accumulator.value, cycles);
+            break;
+
+        default:
+            break;
+        }
     }
+
+    firstEvent = (firstEvent + eventsNum) % EventsCapacity;
+    eventsNum = 0;
+
+    // folding in the middle of a run counts as timers work
+    if(recording)
+    {
+        ULONG64 foldEnd;
+        QueryThreadCycleTime(GetCurrentThread(), &foldEnd);
+
+        timersWorkCycles += foldEnd - foldStart;
+    }
+}
+
+BenchmarkCounter::BenchmarkCounter(const BenchmarkCounterSite *inSite)
+    : site(inSite)
+{
+    BenchmarkTimerRecorder::getThreadRecorder().registerCounter(this);
+}
+
+BenchmarkCounter::~BenchmarkCounter()
+{
+    BenchmarkTimerRecorder::getThreadRecorder().unregisterCounter(this);
 }
@@ -1,6 +1,13 @@
 #ifndef BENCHMARK_TIMERS_H
 #define BENCHMARK_TIMERS_H
 
+#include "benchmark_call_tree.h"
+#include "benchmark_run_info.h"
+#include "benchmark_statistics.h"
+#include "benchmark_trace.h"
+#include "complexity_analysis.h"
+#include "complexity_expression.h"
+
 #include <windows.h>
 
 #include <QColor>
@@ -8,34 +15,87 @@
 #include <QHash>
 #include <QPointF>
 
-class Algorithm;
-
-#define BENCHMARK_SCOPED_TIMER(name, color, aggregationMode) BenchmarkScopedTimer scopedTimer##__LINE__(this, name, color, aggregationMode);
+#include <memory>
 
 enum class AggregationMode
 {
-    Sum,   // total accumulated time across all iterations
+    Sum,   // total accumulated time within a run, averaged over repetitions
     Min,   // the shortest single iteration time
     Max    // the longest single iteration time
 };
 
+// Compile-time description of a timer site, its address is the timer id so nothing is registered at runtime
+struct BenchmarkTimerSite
+{
+    const char* name;
+    Qt::GlobalColor color;
+    AggregationMode aggregationMode;
+};
+
+#define BENCHMARK_TIMER_CONCAT_IMPL(a, b) a##b
+#define BENCHMARK_TIMER_CONCAT(a, b) BENCHMARK_TIMER_CONCAT_IMPL(a, b)
+
+// timers are compiled in only with the ALGORITHMS_BENCHMARK_TIMERS cmake option, otherwise the macro is empty
+#ifdef BENCHMARK_TIMERS_ENABLED
+#define BENCHMARK_SCOPED_TIMER(name, color, aggregationMode) \
+    static constexpr BenchmarkTimerSite BENCHMARK_TIMER_CONCAT(benchmarkTimerSite, __LINE__){name, color, aggregationMode}; \
+    BenchmarkScopedTimer BENCHMARK_TIMER_CONCAT(scopedTimer, __LINE__)(&BENCHMARK_TIMER_CONCAT(benchmarkTimerSite, __LINE__));
+#else
+#define BENCHMARK_SCOPED_TIMER(name, color, aggregationMode)
+#endif
+
+// Compile-time description of a work counter, counters report machine-independent work such as relaxations or heap operations
+struct BenchmarkCounterSite
+{
+    const char* name;
+    Qt::GlobalColor color;
+};
+
+// counters are compiled in only with the ALGORITHMS_BENCHMARK_COUNTERS cmake option, otherwise the macros are empty
+#ifdef BENCHMARK_COUNTERS_ENABLED
+#define BENCHMARK_COUNTER_ADD(name, color, amount) \
+    { \
+        static constexpr BenchmarkCounterSite benchmarkCounterSite{name, color}; \
+        static thread_local BenchmarkCounter benchmarkCounter(&benchmarkCounterSite); \
+        benchmarkCounter.add(amount); \
+    }
+#else
+#define BENCHMARK_COUNTER_ADD(name, color, amount)
+#endif
+
+#define BENCHMARK_COUNTER(name, color) BENCHMARK_COUNTER_ADD(name, color, 1)
+
 struct SubSeriesData
 {
     QColor color;
+    AggregationMode aggregationMode = AggregationMode::Sum;
+    bool isCounter = false; // operations per run instead of cycles
     QList<QPointF> points;
 };
 
 struct AlgorithmBenchmarkResult
 {
     QList<QPointF> mainSeries;
+    QList<BenchmarkStatistics> mainSeriesStatistics; // parallel to mainSeries
+    QList<ComplexityVariables> mainSeriesInputs; // parallel to mainSeries, averaged over all graphs of a point
+    ComplexityAnalysis complexityAnalysis;
     QString toolTipInfo;
+    QString variantName; // set when one run produces several results, e.g. one per graph representation
+    BenchmarkRunInfo runInfo;
     QHash<QString, SubSeriesData> subSeriesNameToSubSeriesData;
+    QList<BenchmarkCallTree> callTrees; // one per size point that ran any timer
 
     void clear()
     {
         mainSeries.clear();
+        mainSeriesStatistics.clear();
+        mainSeriesInputs.clear();
+        complexityAnalysis = ComplexityAnalysis();
         toolTipInfo.clear();
+        variantName.clear();
+        runInfo = BenchmarkRunInfo();
         subSeriesNameToSubSeriesData.clear();
+        callTrees.clear();
     }
 
     SubSeriesData& operator[](const QString& name)
@@ -44,38 +104,239 @@ struct AlgorithmBenchmarkResult
     }
 };
 
-class AlgorithmBenchmarkTimerManager
+// Cycles spent by a single timer invocation, measured once at startup by BenchmarkTimerRecorder::calibrateOverhead
+struct BenchmarkTimerOverhead
+{
+    ULONG64 innerCycles = 0; // part of the overhead that lands between the two cycle counter reads
+    ULONG64 totalCycles = 0; // whole cost of an invocation, seen by the enclosing timers and the measured run
+};
+
+struct BenchmarkTimerEvent
+{
+    int node;
+    quint32 iteration;
+    ULONG64 cycles;
+    ULONG64 selfCycles;
+};
+
+class BenchmarkScopedTimer;
+class BenchmarkCounter;
+
+/**
+ * Per thread recorder of raw timer events. Recording is lock-free since only the owning thread writes
+ * to its own preallocated ring, events are turned into sub-series points after the iteration completes.
+ * Running timers form a stack, every site gets one call tree node per distinct parent node, so equal names
+ * under different parents do not collide. A site entered again while it is running (recursion) is merged into
+ * the outer invocation.
+ */
+class BenchmarkTimerRecorder
 {
 public:
-    friend class BenchmarkScopedTimer;
+    static constexpr int EventsCapacity = 1 << 16;
+    static constexpr int CallTreeNodesCapacity = 1024; // timers beyond it are not recorded
+    static constexpr const char* ClockBackend = "QueryThreadCycleTime (thread cycles)";
 
-    static AlgorithmBenchmarkTimerManager& getTimerManager();
+    static BenchmarkTimerRecorder& getThreadRecorder();
 
-    QHash<const Algorithm*, AlgorithmBenchmarkResult> algorithmToResultData;
+    void reset();
+
+    void startRecording(int inIteration);
+    void stopRecording();
+
+    bool isRecording() const
+    {
+        return recording;
+    }
+
+    quint64 getInvocationsNum() const
+    {
+        return invocationsNum;
+    }
+
+    inline bool enter(BenchmarkScopedTimer* timer);
+
+    // pops the timer, the calibrated overhead of this invocation and of the nestedInvocationsNum timers inside it is subtracted
+    inline void record(BenchmarkScopedTimer* timer, ULONG64 cycles, quint64 nestedInvocationsNum);
 
     ULONG64 takeTimersWorkCycles();
-    void clear(const Algorithm* algorithm);
+
+    void registerCounter(BenchmarkCounter* counter);
+    void unregisterCounter(BenchmarkCounter* counter);
+
+    // measures BenchmarkTimerOverhead on the calling thread, call before any benchmark is started
+    static void calibrateOverhead();
+    static const BenchmarkTimerOverhead& getOverhead();
+
+    /**
+     * Aggregates everything recorded since the last flush into points at x and a call tree of the point.
+     * Sum timers and the call tree are averaged over runsNum. Nested timers are named by their path, e.g. "DFSHelper / findStart".
+     */
+    void flush(AlgorithmBenchmarkResult& resultData, qreal x, int runsNum);
 
 private:
-    ULONG64 timersWorkCycles = 0;
+    BenchmarkTimerRecorder();
+
+    void foldEvents();
+
+    int findOrAddNode(int parentNode, const BenchmarkTimerSite* site);
+
+    QString getNodePath(int node) const;
+
+    static constexpr int RootNode = 0;
+
+    struct CallTreeNode
+    {
+        const BenchmarkTimerSite* site;
+        int parent;
+        int firstChild;
+        int nextSibling;
+    };
+
+    struct TimerAccumulator
+    {
+        bool hasValue = false;
+        qreal value = 0.0; // aggregated with the aggregation mode of the site
+        qreal totalCycles = 0.0;
+        qreal selfCycles = 0.0;
+        quint64 callsNum = 0;
+    };
+
+    std::unique_ptr<BenchmarkTimerEvent[]> events;
+    int firstEvent;
+    int eventsNum;
+
+    // preallocated, so entering a timer never allocates
+    std::unique_ptr<CallTreeNode[]> callTreeNodes;
+    std::unique_ptr<TimerAccumulator[]> accumulators;
+    int callTreeNodesNum;
+
+    BenchmarkScopedTimer* currentTimer;
+
+    QList<BenchmarkCounter*> counters;
+
+    quint32 iteration;
+    bool recording;
+
+    quint64 invocationsNum;
+    quint64 takenInvocationsNum;
+    ULONG64 timersWorkCycles;
+
+    static inline BenchmarkTimerOverhead overhead;
 };
 
 class BenchmarkScopedTimer
 {
 public:
-    BenchmarkScopedTimer(const Algorithm* inAlgorithm, const QString &inName, const QColor &inColor, AggregationMode inAggregationMode);
-    ~BenchmarkScopedTimer();
+    explicit BenchmarkScopedTimer(const BenchmarkTimerSite* inSite)
+        : site(inSite)
+        , traceScope(inSite->name, "timer")
+        , recorder(BenchmarkTimerRecorder::getThreadRecorder())
+        , recording(recorder.isRecording() && recorder.enter(this))
+    {
+        if(recording)
+        {
+            startInvocationsNum = recorder.getInvocationsNum();
+            QueryThreadCycleTime(GetCurrentThread(), &start);
+        }
+    }
 
-protected:
-    QString name;
-    QColor color;
-    AggregationMode aggregationMode;
+    ~BenchmarkScopedTimer()
+    {
+        if(recording)
+        {
+            ULONG64 end;
+            QueryThreadCycleTime(GetCurrentThread(), &end);
+
+            recorder.record(this, end - start, recorder.getInvocationsNum() - startInvocationsNum);
+        }
+    }
 
 private:
+    friend class BenchmarkTimerRecorder;
+
+    const BenchmarkTimerSite* site;
+    TraceScope traceScope; // outlives the recording, so the trace event covers the whole timer
+    BenchmarkTimerRecorder& recorder;
+
+    BenchmarkScopedTimer* parent = nullptr;
+    int node = -1;
+    ULONG64 childrenCycles = 0;
+
+    bool recording;
+
+    quint64 startInvocationsNum;
     ULONG64 start;
-    ULONG64 end;
+};
+
+// Counts an operation of a kernel, used through BENCHMARK_COUNTER, one instance per site and thread
+class BenchmarkCounter
+{
+public:
+    explicit BenchmarkCounter(const BenchmarkCounterSite* inSite);
+    ~BenchmarkCounter();
 
-    const Algorithm* algorithm;
+    BenchmarkCounter(const BenchmarkCounter&) = delete;
+    BenchmarkCounter& operator=(const BenchmarkCounter&) = delete;
+
+    void add(quint64 amount)
+    {
+        value += amount;
+    }
+
+private:
+    friend class BenchmarkTimerRecorder;
+
+    const BenchmarkCounterSite* site;
+
+    quint64 value = 0;
+    quint64 valueAtRecordingStart = 0;
+    quint64 recordedValue = 0; // counted while recording since the last flush
 };
 
+bool BenchmarkTimerRecorder::enter(BenchmarkScopedTimer *timer)
+{
+    for(const BenchmarkScopedTimer* runningTimer = currentTimer; runningTimer; runningTimer = runningTimer->parent)
+    {
+        if(runningTimer->site == timer->site)
+        {
+            return false;
+        }
+    }
+
+    const int node = findOrAddNode(currentTimer ? currentTimer->node : RootNode, timer->site);
+    if(node < 0)
+    {
+        return false;
+    }
+
+    timer->parent = currentTimer;
+    timer->node = node;
+    currentTimer = timer;
+
+    return true;
+}
+
+void BenchmarkTimerRecorder::record(BenchmarkScopedTimer *timer, ULONG64 cycles, quint64 nestedInvocationsNum)
+{
+    currentTimer = timer->parent;
+
+    if(eventsNum == EventsCapacity)
+    {
+        foldEvents();
+    }
+
+    const ULONG64 overheadCycles = overhead.innerCycles + nestedInvocationsNum * overhead.totalCycles;
+    cycles = cycles > overheadCycles ? cycles - overheadCycles : 0;
+
+    const ULONG64 selfCycles = cycles > timer->childrenCycles ? cycles - timer->childrenCycles : 0;
+
+    if(timer->parent)
+    {
+        timer->parent->childrenCycles += cycles;
+    }
+
+    events[(firstEvent + eventsNum++) % EventsCapacity] = BenchmarkTimerEvent{timer->node, iteration, cycles, selfCycles};
+    invocationsNum++;
+}
+
 #endif // BENCHMARK_TIMERS_H
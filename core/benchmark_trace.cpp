@@ -0,0 +1,171 @@
+#include "benchmark_trace.h"
+
+#include <windows.h>
+
+#include <QFile>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+
+#include <algorithm>
+
+namespace
+{
+    QMutex sessionMutex;
+    QSet<QByteArray> internedNames;
+
+    QMutex traceFileMutex;
+    QHash<QString, qint64> writtenEventsNums; // events in every trace file written in this session
+
+    qint64 getPerformanceFrequency()
+    {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        return frequency.QuadPart;
+    }
+}
+
+TraceRecorder &TraceRecorder::getThreadRecorder()
+{
+    static thread_local TraceRecorder traceRecorder;
+    return traceRecorder;
+}
+
+qint64 TraceRecorder::now()
+{
+    static const qint64 frequency = getPerformanceFrequency();
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+
+    // split to avoid overflowing when the counter is multiplied
+    const qint64 seconds = counter.QuadPart / frequency;
+    const qint64 remainder = counter.QuadPart % frequency;
+
+    return seconds * 1000000000 + remainder * 1000000000 / frequency;
+}
+
+const char *TraceRecorder::internName(const QString &name)
+{
+    QMutexLocker locker(&sessionMutex);
+
+    // the set may move its elements when it grows, the character data of a QByteArray stays where it is
+    return internedNames.insert(name.toUtf8())->constData();
+}
+
+TraceRecorder::TraceRecorder()
+    : events(new TraceEvent[EventsCapacity])
+    , firstEvent(0)
+    , eventsNum(0)
+    , droppedEventsNum(0)
+    , threadId(GetCurrentThreadId())
+    , recording(false)
+{
+
+}
+
+void TraceRecorder::start()
+{
+    firstEvent = 0;
+    eventsNum = 0;
+    droppedEventsNum = 0;
+    recording = true;
+}
+
+void TraceRecorder::stop()
+{
+    recording = false;
+}
+
+QList<TraceEvent> TraceRecorder::takeEvents()
+{
+    QList<TraceEvent> takenEvents;
+    takenEvents.reserve(eventsNum);
+
+    for(int i = 0; i < eventsNum; ++i)
+    {
+        takenEvents.append(events[(firstEvent + i) % EventsCapacity]);
+    }
+
+    firstEvent = 0;
+    eventsNum = 0;
+
+    return takenEvents;
+}
+
+quint64 TraceRecorder::getDroppedEventsNum() const
+{
+    return droppedEventsNum;
+}
+
+bool TraceFile::appendEvents(const QList<TraceEvent> &events, QString &outInfo, const QString &filePath)
+{
+    const qint64 processId = static_cast<qint64>(GetCurrentProcessId());
+
+    QByteArray eventsAsJson;
+    QList<qsizetype> eventEnds;
+    eventEnds.reserve(events.size());
+
+    for(const TraceEvent& event : events)
+    {
+        // timestamps of the format are microseconds
+        QJsonObject eventAsJsonObject;
+        eventAsJsonObject["name"] = QString::fromUtf8(event.name);
+        eventAsJsonObject["cat"] = QString::fromLatin1(event.category);
+        eventAsJsonObject["ph"] = "X";
+        eventAsJsonObject["ts"] = event.startNs / 1000.0;
+        eventAsJsonObject["dur"] = event.durationNs / 1000.0;
+        eventAsJsonObject["pid"] = processId;
+        eventAsJsonObject["tid"] = static_cast<qint64>(event.threadId);
+
+        eventsAsJson.append(",\n");
+        eventsAsJson.append(QJsonDocument(eventAsJsonObject).toJson(QJsonDocument::Compact));
+        eventEnds.append(eventsAsJson.size());
+    }
+
+    QMutexLocker locker(&traceFileMutex);
+
+    const auto it = writtenEventsNums.constFind(filePath);
+    const bool isNewFile = it == writtenEventsNums.constEnd();
+    const qint64 writtenEventsNum = isNewFile ? 0 : it.value();
+
+    const qint64 acceptedEventsNum = std::min<qint64>(events.size(), MaxEventsNum - writtenEventsNum);
+
+    QFile traceFile(filePath);
+    if(!traceFile.open(isNewFile ? QIODevice::WriteOnly | QIODevice::Truncate : QIODevice::WriteOnly | QIODevice::Append))
+    {
+        outInfo = "Cannot open " + filePath + " for writing: " + traceFile.errorString();
+        return false;
+    }
+
+    // the array format may end without its closing bracket, so events can be appended as they come
+    if(isNewFile && traceFile.write("[") != 1)
+    {
+        outInfo = "Cannot write to " + filePath + ": " + traceFile.errorString();
+        return false;
+    }
+
+    if(acceptedEventsNum > 0)
+    {
+        const qsizetype skippedBytes = writtenEventsNum == 0 ? 1 : 0;
+        const qsizetype writtenBytes = eventEnds[acceptedEventsNum - 1] - skippedBytes;
+
+        if(traceFile.write(eventsAsJson.constData() + skippedBytes, writtenBytes) != writtenBytes)
+        {
+            outInfo = "Cannot write to " + filePath + ": " + traceFile.errorString();
+            return false;
+        }
+    }
+
+    writtenEventsNums[filePath] = writtenEventsNum + acceptedEventsNum;
+
+    if(acceptedEventsNum < events.size())
+    {
+        outInfo = "the file reached " + QString::number(MaxEventsNum) + " events, the newest " + QString::number(events.size() - acceptedEventsNum) + " were not written";
+    }
+
+    return true;
+}
@@ -0,0 +1,119 @@
+#ifndef BENCHMARK_TRACE_H
+#define BENCHMARK_TRACE_H
+
+#include <QList>
+#include <QString>
+
+#include <memory>
+
+// One complete event of the Chrome trace event format
+struct TraceEvent
+{
+    const char* name; // a static text or a name from TraceRecorder::internName, so recording never allocates
+    const char* category;
+    qint64 startNs;
+    qint64 durationNs;
+    quint32 threadId;
+};
+
+/**
+ * Per thread bounded ring of trace events, enabled for a single benchmark run or visualization.
+ * When the ring is full the oldest events are overwritten, so the end of a long run is always kept.
+ */
+class TraceRecorder
+{
+public:
+    static constexpr int EventsCapacity = 1 << 16;
+
+    static TraceRecorder& getThreadRecorder();
+
+    static qint64 now();
+
+    // the returned text lives until the application exits
+    static const char* internName(const QString& name);
+
+    void start();
+    void stop();
+
+    bool isRecording() const
+    {
+        return recording;
+    }
+
+    void record(const char* name, const char* category, qint64 startNs, qint64 endNs)
+    {
+        events[(firstEvent + eventsNum) % EventsCapacity] = TraceEvent{name, category, startNs, endNs - startNs, threadId};
+
+        if(eventsNum < EventsCapacity)
+        {
+            eventsNum++;
+        }
+        else
+        {
+            firstEvent = (firstEvent + 1) % EventsCapacity;
+            droppedEventsNum++;
+        }
+    }
+
+    QList<TraceEvent> takeEvents();
+
+    quint64 getDroppedEventsNum() const;
+
+private:
+    TraceRecorder();
+
+    std::unique_ptr<TraceEvent[]> events;
+    int firstEvent;
+    int eventsNum;
+    quint64 droppedEventsNum;
+
+    quint32 threadId;
+    bool recording;
+};
+
+// Records its lifetime as a trace event when the thread recorder is on
+class TraceScope
+{
+public:
+    TraceScope(const char* inName, const char* inCategory)
+        : name(inName)
+        , category(inCategory)
+        , recorder(TraceRecorder::getThreadRecorder())
+        , recording(recorder.isRecording())
+        , start(recording ? TraceRecorder::now() : 0)
+    {
+
+    }
+
+    ~TraceScope()
+    {
+        if(recording)
+        {
+            recorder.record(name, category, start, TraceRecorder::now());
+        }
+    }
+
+private:
+    const char* name;
+    const char* category;
+    TraceRecorder& recorder;
+    bool recording;
+    qint64 start;
+};
+
+/**
+ * Trace of every run recorded in this session in the JSON array variant of the Chrome trace event format,
+ * so it can be opened in chrome://tracing or ui.perfetto.dev. The events of each run are appended to the file,
+ * the array is left open as the format allows. Events beyond MaxEventsNum per file are not written.
+ * On success outInfo is set only when events were left out.
+ */
+class TraceFile
+{
+public:
+    static inline const QString DefaultFilePath = "benchmark trace.json";
+    static constexpr int MaxEventsNum = 1 << 20;
+
+    static bool appendEvents(const QList<TraceEvent>& events, QString& outInfo, const QString& filePath = DefaultFilePath);
+};
+
+#endif // BENCHMARK_TRACE_H
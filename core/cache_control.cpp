@@ -0,0 +1,134 @@
+#include "cache_control.h"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+namespace
+{
+    constexpr qsizetype DefaultLastLevelCacheSize = 32 * 1024 * 1024;
+    constexpr qsizetype EvictionBufferFactor = 4;
+    constexpr qsizetype CacheLineSize = 64;
+
+    qsizetype queryLastLevelCacheSize()
+    {
+        DWORD bufferSize = 0;
+        GetLogicalProcessorInformation(nullptr, &bufferSize);
+        if(bufferSize == 0)
+        {
+            return DefaultLastLevelCacheSize;
+        }
+
+        QList<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> processorInformation(bufferSize / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+        if(!GetLogicalProcessorInformation(processorInformation.data(), &bufferSize))
+        {
+            return DefaultLastLevelCacheSize;
+        }
+
+        qsizetype cacheSize = 0;
+        for(const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& information : std::as_const(processorInformation))
+        {
+            if(information.Relationship == RelationCache && information.Cache.Type != CacheInstruction)
+            {
+                cacheSize = std::max<qsizetype>(cacheSize, information.Cache.Size);
+            }
+        }
+
+        return cacheSize > 0 ? cacheSize : DefaultLastLevelCacheSize;
+    }
+}
+
+namespace CacheControl
+{
+    qsizetype getLastLevelCacheSize()
+    {
+        static const qsizetype lastLevelCacheSize = queryLastLevelCacheSize();
+        return lastLevelCacheSize;
+    }
+
+    void evictCaches()
+    {
+        const qsizetype bufferSize = EvictionBufferFactor * getLastLevelCacheSize();
+
+        // allocated once per thread, so concurrent benchmarks do not share lines and nothing is allocated in later calls
+        thread_local std::unique_ptr<char[]> buffer;
+        thread_local qsizetype allocatedSize = 0;
+
+        if(allocatedSize < bufferSize)
+        {
+            buffer.reset(new char[bufferSize]());
+            allocatedSize = bufferSize;
+        }
+
+        // writing takes every line in exclusive state, reading it back keeps the loop from being optimized out
+        char* data = buffer.get();
+        for(qsizetype i = 0; i < bufferSize; i += CacheLineSize)
+        {
+            data[i]++;
+        }
+
+        volatile char sink = 0;
+        for(qsizetype i = 0; i < bufferSize; i += CacheLineSize)
+        {
+            sink = sink + data[i];
+        }
+    }
+
+    QList<int> getAvailableCores()
+    {
+        QList<int> cores;
+
+        DWORD_PTR processMask = 0;
+        DWORD_PTR systemMask = 0;
+        if(!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+        {
+            return cores;
+        }
+
+        for(int core = 0; core < static_cast<int>(sizeof(DWORD_PTR) * 8); ++core)
+        {
+            if(processMask & (static_cast<DWORD_PTR>(1) << core))
+            {
+                cores.append(core);
+            }
+        }
+
+        return cores;
+    }
+}
+
+ThreadAffinityGuard::ThreadAffinityGuard()
+    : previousMask(0)
+{
+
+}
+
+ThreadAffinityGuard::~ThreadAffinityGuard()
+{
+    if(previousMask != 0)
+    {
+        SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(previousMask));
+    }
+}
+
+bool ThreadAffinityGuard::moveTo(int core)
+{
+    const DWORD_PTR mask = SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << core);
+    if(mask == 0)
+    {
+        return false;
+    }
+
+    // only the affinity from before the first move is restored
+    if(previousMask == 0)
+    {
+        previousMask = static_cast<quintptr>(mask);
+    }
+
+    // the new affinity takes effect at the next reschedule, yielding makes it immediate
+    SwitchToThread();
+
+    return true;
+}
@@ -0,0 +1,46 @@
+#ifndef CACHE_CONTROL_H
+#define CACHE_CONTROL_H
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+// What the caches hold when a measured run starts
+namespace CacheModes
+{
+    inline const QString AfterBuild = "after build"; // nothing is done, the measured run follows building or the previous run
+    inline const QString Warm = "warm"; // the same graph was just processed, only the last of two runs is measured
+    inline const QString Cold = "cold"; // caches are evicted between building the graph and running the algorithm
+    inline const QString OtherCore = "other core"; // the graph is touched on the builder core, the algorithm runs on another one
+
+    inline const QStringList All = {AfterBuild, Warm, Cold, OtherCore};
+}
+
+namespace CacheControl
+{
+    // size in bytes of the largest data cache reported by the system, a conservative guess when it is unknown
+    qsizetype getLastLevelCacheSize();
+
+    // streams through a thread-local buffer a few times larger than the last level cache, so earlier data is no longer cached
+    void evictCaches();
+
+    QList<int> getAvailableCores();
+}
+
+// Pins the current thread to one logical processor at a time, the previous affinity is restored on destruction
+class ThreadAffinityGuard
+{
+public:
+    ThreadAffinityGuard();
+    ~ThreadAffinityGuard();
+
+    ThreadAffinityGuard(const ThreadAffinityGuard&) = delete;
+    ThreadAffinityGuard& operator=(const ThreadAffinityGuard&) = delete;
+
+    bool moveTo(int core);
+
+private:
+    quintptr previousMask;
+};
+
+#endif // CACHE_CONTROL_H
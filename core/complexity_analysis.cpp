@@ -0,0 +1,168 @@
+#include "complexity_analysis.h"
+#include "benchmark_statistics.h"
+
+#include <QJsonArray>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+ComplexityFit ComplexityFit::fit(const QString &complexityName, const QList<qreal> &modelValues, const QList<qreal> &times)
+{
+    ComplexityFit complexityFit;
+    complexityFit.complexityName = complexityName;
+    complexityFit.relativeResidual = std::numeric_limits<qreal>::infinity();
+
+    // time is fitted relatively (weights 1/t^2), otherwise the largest points would decide everything
+    QList<qreal> ratios;
+    ratios.reserve(times.size());
+
+    const qsizetype pointsNum = std::min(modelValues.size(), times.size());
+    for(qsizetype i = 0; i < pointsNum; ++i)
+    {
+        if(std::isfinite(modelValues[i]) && modelValues[i] > 0.0 && times[i] > 0.0)
+        {
+            ratios.append(modelValues[i] / times[i]);
+        }
+    }
+
+    complexityFit.pointsNum = ratios.size();
+    if(ratios.size() < 2)
+    {
+        return complexityFit;
+    }
+
+    qreal ratiosSum = 0.0;
+    qreal squaredRatiosSum = 0.0;
+    for(qreal ratio : ratios)
+    {
+        ratiosSum += ratio;
+        squaredRatiosSum += ratio * ratio;
+    }
+
+    complexityFit.constantFactor = ratiosSum / squaredRatiosSum;
+
+    qreal squaredErrorsSum = 0.0;
+    for(qreal ratio : ratios)
+    {
+        const qreal relativeError = 1.0 - complexityFit.constantFactor * ratio;
+        squaredErrorsSum += relativeError * relativeError;
+    }
+
+    complexityFit.relativeResidual = std::sqrt(squaredErrorsSum / ratios.size());
+
+    return complexityFit;
+}
+
+QJsonObject ComplexityFit::toJsonObject() const
+{
+    QJsonObject fitAsJsonObject;
+    fitAsJsonObject["complexity"] = complexityName;
+    fitAsJsonObject["constantFactor"] = constantFactor;
+    fitAsJsonObject["relativeResidual"] = std::isfinite(relativeResidual) ? relativeResidual : -1.0;
+    fitAsJsonObject["pointsNum"] = pointsNum;
+
+    return fitAsJsonObject;
+}
+
+EmpiricalExponent EmpiricalExponent::estimate(const QList<qreal> &sizes, const QList<qreal> &times)
+{
+    QList<qreal> logSizes;
+    QList<qreal> logTimes;
+
+    const qsizetype pointsNum = std::min(sizes.size(), times.size());
+    for(qsizetype i = 0; i < pointsNum; ++i)
+    {
+        if(sizes[i] > 1.0 && times[i] > 0.0)
+        {
+            logSizes.append(std::log(sizes[i]));
+            logTimes.append(std::log(times[i]));
+        }
+    }
+
+    const LinearRegressionResult regression = BenchmarkStatisticsUtils::linearRegression(logSizes, logTimes);
+
+    EmpiricalExponent empiricalExponent;
+    empiricalExponent.isValid = regression.isValid;
+    empiricalExponent.exponent = regression.slope;
+    empiricalExponent.rSquared = regression.rSquared;
+
+    return empiricalExponent;
+}
+
+QJsonObject EmpiricalExponent::toJsonObject() const
+{
+    QJsonObject exponentAsJsonObject;
+    exponentAsJsonObject["isValid"] = isValid;
+    exponentAsJsonObject["exponent"] = exponent;
+    exponentAsJsonObject["rSquared"] = rSquared;
+
+    return exponentAsJsonObject;
+}
+
+bool ComplexityAnalysis::isEmpty() const
+{
+    return rankedFits.isEmpty() && !nodesExponent.isValid && !edgesExponent.isValid;
+}
+
+void ComplexityAnalysis::rank()
+{
+    std::stable_sort(rankedFits.begin(), rankedFits.end(), [](const ComplexityFit& a, const ComplexityFit& b)
+    {
+        return a.relativeResidual < b.relativeResidual;
+    });
+}
+
+void ComplexityAnalysis::appendInfo(QString &infoText, int shownFitsNum) const
+{
+    if(isEmpty())
+    {
+        return;
+    }
+
+    infoText.append("best fitting complexities :\n");
+
+    for(int i = 0; i < rankedFits.size() && i < shownFitsNum; ++i)
+    {
+        const ComplexityFit& complexityFit = rankedFits[i];
+        if(!std::isfinite(complexityFit.relativeResidual))
+        {
+            break;
+        }
+
+        infoText.append("  " + QString::number(i + 1) + ". " + complexityFit.complexityName
+                        + " : c = " + QString::number(complexityFit.constantFactor, 'g', 4)
+                        + ", residual = " + QString::number(complexityFit.relativeResidual * 100.0, 'f', 1) + "%");
+        infoText.append("\n");
+    }
+
+    if(nodesExponent.isValid)
+    {
+        infoText.append("empirical exponent (V) : " + QString::number(nodesExponent.exponent, 'f', 2)
+                        + " (R^2 = " + QString::number(nodesExponent.rSquared, 'f', 3) + ")");
+        infoText.append("\n");
+    }
+
+    if(edgesExponent.isValid)
+    {
+        infoText.append("empirical exponent (E) : " + QString::number(edgesExponent.exponent, 'f', 2)
+                        + " (R^2 = " + QString::number(edgesExponent.rSquared, 'f', 3) + ")");
+        infoText.append("\n");
+    }
+}
+
+QJsonObject ComplexityAnalysis::toJsonObject() const
+{
+    QJsonArray fitsAsJsonArray;
+    for(const ComplexityFit& complexityFit : rankedFits)
+    {
+        fitsAsJsonArray.append(complexityFit.toJsonObject());
+    }
+
+    QJsonObject analysisAsJsonObject;
+    analysisAsJsonObject["rankedFits"] = fitsAsJsonArray;
+    analysisAsJsonObject["nodesExponent"] = nodesExponent.toJsonObject();
+    analysisAsJsonObject["edgesExponent"] = edgesExponent.toJsonObject();
+
+    return analysisAsJsonObject;
+}
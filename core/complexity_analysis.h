@@ -0,0 +1,47 @@
+#ifndef COMPLEXITY_ANALYSIS_H
+#define COMPLEXITY_ANALYSIS_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+// Least squares fit of time = constantFactor * f(I, V, E) for a single complexity model
+struct ComplexityFit
+{
+    QString complexityName;
+    qreal constantFactor = 0.0;
+    qreal relativeResidual = 0.0; // root mean square of relative errors, lower is better
+    int pointsNum = 0;
+
+    /** points where the model is not positive and finite or the time is not positive are skipped */
+    static ComplexityFit fit(const QString& complexityName, const QList<qreal>& modelValues, const QList<qreal>& times);
+
+    QJsonObject toJsonObject() const;
+};
+
+// Slope of the log-log regression, time ~ size^exponent
+struct EmpiricalExponent
+{
+    bool isValid = false;
+    qreal exponent = 0.0;
+    qreal rSquared = 0.0;
+
+    static EmpiricalExponent estimate(const QList<qreal>& sizes, const QList<qreal>& times);
+
+    QJsonObject toJsonObject() const;
+};
+
+struct ComplexityAnalysis
+{
+    QList<ComplexityFit> rankedFits;
+    EmpiricalExponent nodesExponent;
+    EmpiricalExponent edgesExponent;
+
+    bool isEmpty() const;
+    void rank();
+
+    void appendInfo(QString& infoText, int shownFitsNum = 5) const;
+    QJsonObject toJsonObject() const;
+};
+
+#endif // COMPLEXITY_ANALYSIS_H
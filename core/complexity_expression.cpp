@@ -0,0 +1,472 @@
+#include "complexity_expression.h"
+
+#include <QHash>
+#include <QVarLengthArray>
+
+#include <cmath>
+#include <limits>
+
+class ComplexityExpression::Parser
+{
+public:
+    Parser(const QString& inText, QList<Instruction>& inProgram)
+        : maxStackSize(0)
+        , text(inText)
+        , program(inProgram)
+        , position(0)
+        , stackSize(0)
+    {
+    }
+
+    bool parse()
+    {
+        skipSpaces();
+        if(position == text.size())
+        {
+            return fail("expression is empty");
+        }
+
+        if(!parseSum())
+        {
+            return false;
+        }
+
+        skipSpaces();
+        if(position != text.size())
+        {
+            return fail("unexpected '" + QString(text[position]) + "'");
+        }
+
+        return true;
+    }
+
+    QString errorString;
+    int maxStackSize;
+
+private:
+    // sum := product (('+' | '-') product)*
+    bool parseSum()
+    {
+        if(!parseProduct())
+        {
+            return false;
+        }
+
+        while(true)
+        {
+            skipSpaces();
+            if(accept('+'))
+            {
+                if(!parseProduct())
+                {
+                    return false;
+                }
+                emitOperation(OpCode::Add, -1);
+            }
+            else if(accept('-'))
+            {
+                if(!parseProduct())
+                {
+                    return false;
+                }
+                emitOperation(OpCode::Subtract, -1);
+            }
+            else
+            {
+                return true;
+            }
+        }
+    }
+
+    // product := unary (('*' | '/') unary)*
+    bool parseProduct()
+    {
+        if(!parseUnary())
+        {
+            return false;
+        }
+
+        while(true)
+        {
+            skipSpaces();
+            if(accept('*'))
+            {
+                if(!parseUnary())
+                {
+                    return false;
+                }
+                emitOperation(OpCode::Multiply, -1);
+            }
+            else if(accept('/'))
+            {
+                if(!parseUnary())
+                {
+                    return false;
+                }
+                emitOperation(OpCode::Divide, -1);
+            }
+            else
+            {
+                return true;
+            }
+        }
+    }
+
+    // unary := '-' unary | power
+    bool parseUnary()
+    {
+        skipSpaces();
+        if(accept('-'))
+        {
+            if(!parseUnary())
+            {
+                return false;
+            }
+            emitOperation(OpCode::Negate, 0);
+            return true;
+        }
+
+        accept('+');
+        return parsePower();
+    }
+
+    // power := primary ('^' unary)?, right associative
+    bool parsePower()
+    {
+        if(!parsePrimary())
+        {
+            return false;
+        }
+
+        skipSpaces();
+        if(accept('^'))
+        {
+            if(!parseUnary())
+            {
+                return false;
+            }
+            emitOperation(OpCode::Power, -1);
+        }
+
+        return true;
+    }
+
+    // primary := number | variable | function '(' sum (',' sum)* ')' | '(' sum ')'
+    bool parsePrimary()
+    {
+        skipSpaces();
+        if(position == text.size())
+        {
+            return fail("unexpected end of expression");
+        }
+
+        if(accept('('))
+        {
+            if(!parseSum())
+            {
+                return false;
+            }
+
+            skipSpaces();
+            return accept(')') || fail("missing ')'");
+        }
+
+        const QChar current = text[position];
+        if(current.isDigit() || current == '.')
+        {
+            return parseNumber();
+        }
+
+        if(current.isLetter())
+        {
+            return parseIdentifier();
+        }
+
+        return fail("unexpected '" + QString(current) + "'");
+    }
+
+    bool parseNumber()
+    {
+        const int start = position;
+        while(position < text.size() && (text[position].isDigit() || text[position] == '.'))
+        {
+            position++;
+        }
+
+        // exponent part, e.g. 1e6
+        if(position < text.size() && (text[position] == 'e' || text[position] == 'E')
+            && position + 1 < text.size() && (text[position + 1].isDigit() || text[position + 1] == '-'))
+        {
+            position += 2;
+            while(position < text.size() && text[position].isDigit())
+            {
+                position++;
+            }
+        }
+
+        bool ok = false;
+        const qreal value = text.mid(start, position - start).toDouble(&ok);
+        if(!ok)
+        {
+            return fail("invalid number '" + text.mid(start, position - start) + "'");
+        }
+
+        Instruction instruction{OpCode::PushConstant};
+        instruction.constant = value;
+        push(instruction);
+
+        return true;
+    }
+
+    bool parseIdentifier()
+    {
+        const int start = position;
+        while(position < text.size() && (text[position].isLetterOrNumber() || text[position] == '_'))
+        {
+            position++;
+        }
+
+        const QString identifier = text.mid(start, position - start);
+
+        static const QHash<QString, qreal ComplexityVariables::*> variables =
+        {
+            {"I",    &ComplexityVariables::iteration},
+            {"V",    &ComplexityVariables::nodesNum},
+            {"E",    &ComplexityVariables::edgesNum},
+            {"Wmin", &ComplexityVariables::minWeight},
+            {"Wmax", &ComplexityVariables::maxWeight},
+        };
+
+        const auto variableIt = variables.constFind(identifier);
+        if(variableIt != variables.constEnd())
+        {
+            Instruction instruction{OpCode::PushVariable};
+            instruction.variable = variableIt.value();
+            push(instruction);
+
+            return true;
+        }
+
+        static const QHash<QString, QPair<int, OpCode>> functions =
+        {
+            {"log",   {1, OpCode::Log}},
+            {"ln",    {1, OpCode::Log}},
+            {"log2",  {1, OpCode::Log2}},
+            {"log10", {1, OpCode::Log10}},
+            {"sqrt",  {1, OpCode::Sqrt}},
+            {"exp",   {1, OpCode::Exp}},
+            {"abs",   {1, OpCode::Abs}},
+            {"min",   {2, OpCode::Min}},
+            {"max",   {2, OpCode::Max}},
+            {"pow",   {2, OpCode::Power}},
+        };
+
+        const auto functionIt = functions.constFind(identifier);
+        if(functionIt == functions.constEnd())
+        {
+            return fail("unknown name '" + identifier + "', use I, V, E, Wmin, Wmax or a function");
+        }
+
+        skipSpaces();
+        if(!accept('('))
+        {
+            return fail("missing '(' after " + identifier);
+        }
+
+        const int argumentsNum = functionIt->first;
+        for(int i = 0; i < argumentsNum; ++i)
+        {
+            if(i > 0)
+            {
+                skipSpaces();
+                if(!accept(','))
+                {
+                    return fail(identifier + " takes " + QString::number(argumentsNum) + " arguments");
+                }
+            }
+
+            if(!parseSum())
+            {
+                return false;
+            }
+        }
+
+        skipSpaces();
+        if(!accept(')'))
+        {
+            return fail("missing ')' after arguments of " + identifier);
+        }
+
+        emitOperation(functionIt->second, 1 - argumentsNum);
+        return true;
+    }
+
+    void push(const Instruction& instruction)
+    {
+        program.append(instruction);
+        stackSize++;
+        maxStackSize = std::max(maxStackSize, stackSize);
+    }
+
+    void emitOperation(OpCode opCode, int stackChange)
+    {
+        program.append(Instruction{opCode});
+        stackSize += stackChange;
+    }
+
+    bool accept(QChar character)
+    {
+        if(position < text.size() && text[position] == character)
+        {
+            position++;
+            return true;
+        }
+        return false;
+    }
+
+    void skipSpaces()
+    {
+        while(position < text.size() && text[position].isSpace())
+        {
+            position++;
+        }
+    }
+
+    bool fail(const QString& error)
+    {
+        if(errorString.isEmpty())
+        {
+            errorString = error;
+        }
+        return false;
+    }
+
+    const QString& text;
+    QList<Instruction>& program;
+
+    int position;
+    int stackSize;
+};
+
+ComplexityExpression::ComplexityExpression(const QString &inText)
+    : text(inText)
+{
+    Parser parser(text, program);
+    if(parser.parse())
+    {
+        maxStackSize = parser.maxStackSize;
+    }
+    else
+    {
+        errorString = parser.errorString;
+        program.clear();
+    }
+}
+
+qreal ComplexityExpression::evaluate(const ComplexityVariables &variables) const
+{
+    if(program.isEmpty())
+    {
+        return std::numeric_limits<qreal>::quiet_NaN();
+    }
+
+    QVarLengthArray<qreal, 16> stack(maxStackSize);
+    int top = -1;
+
+    for(const Instruction& instruction : program)
+    {
+        switch (instruction.opCode)
+        {
+        case OpCode::PushConstant:
+            stack[++top] = instruction.constant;
+            break;
+
+        case OpCode::PushVariable:
+            stack[++top] = variables.*instruction.variable;
+            break;
+
+        case OpCode::Add:
+            stack[top - 1] += stack[top];
+            top--;
+            break;
+
+        case OpCode::Subtract:
+            stack[top - 1] -= stack[top];
+            top--;
+            break;
+
+        case OpCode::Multiply:
+            stack[top - 1] *= stack[top];
+            top--;
+            break;
+
+        case OpCode::Divide:
+            stack[top - 1] /= stack[top];
+            top--;
+            break;
+
+        case OpCode::Power:
+            stack[top - 1] = std::pow(stack[top - 1], stack[top]);
+            top--;
+            break;
+
+        case OpCode::Min:
+            stack[top - 1] = std::min(stack[top - 1], stack[top]);
+            top--;
+            break;
+
+        case OpCode::Max:
+            stack[top - 1] = std::max(stack[top - 1], stack[top]);
+            top--;
+            break;
+
+        case OpCode::Negate:
+            stack[top] = -stack[top];
+            break;
+
+        case OpCode::Log:
+            stack[top] = std::log(stack[top]);
+            break;
+
+        case OpCode::Log2:
+            stack[top] = std::log2(stack[top]);
+            break;
+
+        case OpCode::Log10:
+            stack[top] = std::log10(stack[top]);
+            break;
+
+        case OpCode::Sqrt:
+            stack[top] = std::sqrt(stack[top]);
+            break;
+
+        case OpCode::Exp:
+            stack[top] = std::exp(stack[top]);
+            break;
+
+        case OpCode::Abs:
+            stack[top] = std::abs(stack[top]);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    return stack[0];
+}
+
+bool ComplexityExpression::isValid() const
+{
+    return !program.isEmpty();
+}
+
+const QString &ComplexityExpression::getText() const
+{
+    return text;
+}
+
+const QString &ComplexityExpression::getErrorString() const
+{
+    return errorString;
+}
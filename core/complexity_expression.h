@@ -0,0 +1,72 @@
+#ifndef COMPLEXITY_EXPRESSION_H
+#define COMPLEXITY_EXPRESSION_H
+
+#include <QList>
+#include <QString>
+
+// Values a complexity expression can refer to: I, V, E, Wmin and Wmax
+struct ComplexityVariables
+{
+    qreal iteration = 0.0;
+    qreal nodesNum = 0.0;
+    qreal edgesNum = 0.0;
+    qreal minWeight = 0.0;
+    qreal maxWeight = 0.0;
+};
+
+/**
+ * Arithmetic expression over ComplexityVariables, for example "E*log2(V)/8" or "V^2*2^V".
+ * The text is parsed once into a postfix program, evaluate() only runs the program on a small stack,
+ * everything is computed in qreal so large models go to infinity instead of overflowing.
+ * Supported: + - * / ^, parentheses, numbers, log (natural), log2, log10, sqrt, exp, abs, min, max, pow.
+ */
+class ComplexityExpression
+{
+public:
+    ComplexityExpression() = default;
+    explicit ComplexityExpression(const QString& inText);
+
+    qreal evaluate(const ComplexityVariables& variables) const;
+
+    bool isValid() const;
+    const QString& getText() const;
+    const QString& getErrorString() const;
+
+private:
+    enum class OpCode
+    {
+        PushConstant,
+        PushVariable,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Power,
+        Negate,
+        Log,
+        Log2,
+        Log10,
+        Sqrt,
+        Exp,
+        Abs,
+        Min,
+        Max
+    };
+
+    struct Instruction
+    {
+        OpCode opCode;
+        qreal constant = 0.0;
+        qreal ComplexityVariables::* variable = nullptr;
+    };
+
+    class Parser;
+
+    QString text;
+    QString errorString;
+
+    QList<Instruction> program;
+    int maxStackSize = 0;
+};
+
+#endif // COMPLEXITY_EXPRESSION_H
@@ -0,0 +1,211 @@
+#include "execution_environment.h"
+
+#include <windows.h>
+#include <powrprof.h>
+
+#include <QSettings>
+
+#include <algorithm>
+
+namespace
+{
+    constexpr int CalibrationLoopLength = 1 << 20;
+    constexpr int CalibrationRunsNum = 5;
+
+    // documented for CallNtPowerInformation but not declared in the SDK headers
+    struct ProcessorPowerInformation
+    {
+        ULONG number;
+        ULONG maxMhz;
+        ULONG currentMhz;
+        ULONG mhzLimit;
+        ULONG maxIdleState;
+        ULONG currentIdleState;
+    };
+
+    // GUID_PROCESSOR_SETTINGS_SUBGROUP and GUID_PROCESSOR_PERF_BOOST_MODE, spelled out so no GUID library is needed
+    constexpr GUID ProcessorSettingsSubgroup = {0x54533251, 0x82be, 0x4824, {0x96, 0xc1, 0x47, 0xb6, 0x0b, 0x74, 0x0d, 0x00}};
+    constexpr GUID ProcessorPerfBoostMode = {0xbe337238, 0x0d82, 0x4146, {0xa9, 0x60, 0x4f, 0x37, 0x49, 0xd4, 0x70, 0xc7}};
+
+    QString queryProcessorModel()
+    {
+        const QSettings processorSettings("HKEY_LOCAL_MACHINE\\HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0", QSettings::NativeFormat);
+        return processorSettings.value("ProcessorNameString").toString().trimmed();
+    }
+}
+
+CpuInfo CpuInfo::query()
+{
+    CpuInfo cpuInfo;
+
+    static const QString processorModel = queryProcessorModel();
+    cpuInfo.model = processorModel;
+    cpuInfo.core = GetCurrentProcessorNumber();
+
+    const DWORD processorsNum = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    QList<ProcessorPowerInformation> powerInformation(processorsNum);
+
+    const ULONG bufferSize = static_cast<ULONG>(powerInformation.size() * sizeof(ProcessorPowerInformation));
+    if(CallNtPowerInformation(ProcessorInformation, nullptr, 0, powerInformation.data(), bufferSize) == 0)
+    {
+        for(const ProcessorPowerInformation& information : std::as_const(powerInformation))
+        {
+            if(static_cast<int>(information.number) == cpuInfo.core)
+            {
+                cpuInfo.baseMhz = information.maxMhz;
+                cpuInfo.currentMhz = information.currentMhz;
+                cpuInfo.limitMhz = information.mhzLimit;
+                break;
+            }
+        }
+    }
+
+    GUID* activeScheme = nullptr;
+    if(PowerGetActiveScheme(nullptr, &activeScheme) == ERROR_SUCCESS)
+    {
+        DWORD nameSize = 0;
+        PowerReadFriendlyName(nullptr, activeScheme, nullptr, nullptr, nullptr, &nameSize);
+
+        QList<wchar_t> name(nameSize / sizeof(wchar_t) + 1, 0);
+        if(PowerReadFriendlyName(nullptr, activeScheme, nullptr, nullptr, reinterpret_cast<UCHAR*>(name.data()), &nameSize) == ERROR_SUCCESS)
+        {
+            cpuInfo.powerScheme = QString::fromWCharArray(name.constData());
+        }
+
+        // the scheme keeps separate values for mains and battery power
+        SYSTEM_POWER_STATUS powerStatus;
+        const bool isOnBattery = GetSystemPowerStatus(&powerStatus) && powerStatus.ACLineStatus == 0;
+
+        DWORD boostMode = 0;
+        const DWORD result = isOnBattery ? PowerReadDCValueIndex(nullptr, activeScheme, &ProcessorSettingsSubgroup, &ProcessorPerfBoostMode, &boostMode)
+                                         : PowerReadACValueIndex(nullptr, activeScheme, &ProcessorSettingsSubgroup, &ProcessorPerfBoostMode, &boostMode);
+        cpuInfo.isTurboEnabled = result == ERROR_SUCCESS && boostMode != 0;
+
+        LocalFree(activeScheme);
+    }
+
+    return cpuInfo;
+}
+
+bool CpuInfo::isFrequencyCapped() const
+{
+    return limitMhz > 0 && limitMhz < baseMhz;
+}
+
+QString CpuInfo::getDescription() const
+{
+    return model + ", core " + QString::number(core) + ", " + QString::number(currentMhz) + " / " + QString::number(baseMhz)
+           + " MHz (limit " + QString::number(limitMhz) + "), power scheme " + powerScheme + ", turbo " + (isTurboEnabled ? "on" : "off");
+}
+
+QJsonObject CpuInfo::toJsonObject() const
+{
+    QJsonObject cpuInfoAsJsonObject;
+    cpuInfoAsJsonObject["model"] = model;
+    cpuInfoAsJsonObject["core"] = core;
+    cpuInfoAsJsonObject["baseMhz"] = baseMhz;
+    cpuInfoAsJsonObject["currentMhz"] = currentMhz;
+    cpuInfoAsJsonObject["limitMhz"] = limitMhz;
+    cpuInfoAsJsonObject["powerScheme"] = powerScheme;
+    cpuInfoAsJsonObject["turbo"] = isTurboEnabled;
+
+    return cpuInfoAsJsonObject;
+}
+
+ThreadPriorityGuard::ThreadPriorityGuard()
+    : previousPriority(GetThreadPriority(GetCurrentThread()))
+    , raised(false)
+{
+
+}
+
+ThreadPriorityGuard::~ThreadPriorityGuard()
+{
+    // pool threads are reused, the next runnable must not inherit the raised priority
+    if(raised)
+    {
+        SetThreadPriority(GetCurrentThread(), previousPriority);
+    }
+}
+
+bool ThreadPriorityGuard::raise()
+{
+    // highest rather than time critical, so the GUI and the system still get a share of the other cores
+    raised = SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST) != 0;
+    return raised;
+}
+
+void ThrottlingDetector::calibrate()
+{
+    referenceCycles = runCalibrationLoop();
+    for(int i = 1; i < CalibrationRunsNum; ++i)
+    {
+        referenceCycles = std::min(referenceCycles, runCalibrationLoop());
+    }
+
+    checksNum = 0;
+    throttledX.clear();
+    lowestSpeed = 1.0;
+    lowestSpeedX = 0.0;
+}
+
+qreal ThrottlingDetector::check(qreal x)
+{
+    const qreal speed = static_cast<qreal>(referenceCycles) / std::max<quint64>(runCalibrationLoop(), 1);
+
+    checksNum++;
+
+    if(speed < ThrottledSpeed)
+    {
+        throttledX.append(x);
+    }
+
+    if(speed < lowestSpeed)
+    {
+        lowestSpeed = speed;
+        lowestSpeedX = x;
+    }
+
+    return speed;
+}
+
+bool ThrottlingDetector::isCalibrated() const
+{
+    return referenceCycles > 0;
+}
+
+QString ThrottlingDetector::getDescription() const
+{
+    if(throttledX.isEmpty())
+    {
+        return QString();
+    }
+
+    return QString::number(throttledX.size()) + " of " + QString::number(checksNum) + " points below "
+           + QString::number(ThrottledSpeed * 100.0, 'f', 0) + "% of the calibrated clock, the first at x = " + QString::number(throttledX.first(), 'g', 6)
+           + ", the lowest " + QString::number(lowestSpeed * 100.0, 'f', 1) + "% at x = " + QString::number(lowestSpeedX, 'g', 6);
+}
+
+quint64 ThrottlingDetector::runCalibrationLoop()
+{
+    ULONG64 start;
+    ULONG64 end;
+
+    QueryThreadCycleTime(GetCurrentThread(), &start);
+
+    // every step depends on the previous one and the seed is volatile, so the loop runs at one step per multiply-add latency
+    volatile quint64 seed = 0x9e3779b97f4a7c15ull;
+    quint64 value = seed;
+    for(int i = 0; i < CalibrationLoopLength; ++i)
+    {
+        value = value * 6364136223846793005ull + 1442695040888963407ull;
+    }
+
+    // stored before the loop is timed as finished, so it cannot move past the end of the measurement
+    volatile quint64 sink = value;
+    (void)sink;
+
+    QueryThreadCycleTime(GetCurrentThread(), &end);
+
+    return end - start;
+}
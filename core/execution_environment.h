@@ -0,0 +1,75 @@
+#ifndef EXECUTION_ENVIRONMENT_H
+#define EXECUTION_ENVIRONMENT_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+// Processor and power state of the logical processor a benchmark runs on
+struct CpuInfo
+{
+    QString model;
+    int core = -1;
+    int baseMhz = 0; // nominal frequency
+    int currentMhz = 0;
+    int limitMhz = 0; // below baseMhz when the power plan or the firmware caps the frequency
+    QString powerScheme; // Windows counterpart of a frequency governor
+    bool isTurboEnabled = false; // processor performance boost mode of the active power scheme
+
+    // the processor the calling thread runs on
+    static CpuInfo query();
+
+    // the power plan or the firmware holds the clock below the nominal one, turbo and drift during a run do not count
+    bool isFrequencyCapped() const;
+
+    QString getDescription() const;
+
+    QJsonObject toJsonObject() const;
+};
+
+// Raises the scheduling priority of the current thread, the previous priority is restored on destruction
+class ThreadPriorityGuard
+{
+public:
+    ThreadPriorityGuard();
+    ~ThreadPriorityGuard();
+
+    ThreadPriorityGuard(const ThreadPriorityGuard&) = delete;
+    ThreadPriorityGuard& operator=(const ThreadPriorityGuard&) = delete;
+
+    bool raise();
+
+private:
+    int previousPriority;
+    bool raised;
+};
+
+/**
+ * Times a fixed chain of dependent integer operations. The cycle counter ticks at a constant rate,
+ * so the same chain takes more cycles when the core runs at a lower clock than during calibration.
+ */
+class ThrottlingDetector
+{
+public:
+    static constexpr qreal ThrottledSpeed = 0.95;
+
+    void calibrate();
+
+    // reference cycles divided by the cycles of a new run, below ThrottledSpeed the point at x counts as throttled
+    qreal check(qreal x);
+
+    bool isCalibrated() const;
+
+    QString getDescription() const;
+
+private:
+    static quint64 runCalibrationLoop();
+
+    quint64 referenceCycles = 0;
+    int checksNum = 0;
+    QList<qreal> throttledX;
+    qreal lowestSpeed = 1.0;
+    qreal lowestSpeedX = 0.0;
+};
+
+#endif // EXECUTION_ENVIRONMENT_H
@@ -75,7 +75,14 @@ QWidget *PropertyEditorFactory::createPropertiesWidget(QObject *object, QWidget*
         const QString propertyNameAsString(metaProperty.name());
         if(propertyNameAsString != "objectName" && !hiddenProperties.contains(propertyNameAsString))
         {
-            layout->addRow(PropertyEditorFactoryUtils::convertCamelCaseToSpaces(metaProperty.name()), createPropertyWidget(metaProperty, object, propertiesWidget));
+            QWidget* propertyWidget = createPropertyWidget(metaProperty, object, propertiesWidget);
+            if(propertyWidget)
+            {
+                // lets the owner of the properties find the editor of a property by its name
+                propertyWidget->setObjectName(propertyNameAsString);
+            }
+
+            layout->addRow(PropertyEditorFactoryUtils::convertCamelCaseToSpaces(metaProperty.name()), propertyWidget);
         }
     }
 
@@ -84,9 +91,10 @@ QWidget *PropertyEditorFactory::createPropertiesWidget(QObject *object, QWidget*
     return propertiesWidget;
 }
 
-void PropertyEditorFactory::addStringListComboBox(QWidget *propertiesWidget, const QStringList &values, const QString& title, QString &changedValue)
+QComboBox* PropertyEditorFactory::addStringListComboBox(QWidget *propertiesWidget, const QStringList &values, const QString& title, QString &changedValue, bool editable)
 {
     QComboBox* comboBox = new QComboBox(propertiesWidget);
+    comboBox->setEditable(editable);
 
     for(const auto& value : values)
     {
@@ -101,6 +109,8 @@ void PropertyEditorFactory::addStringListComboBox(QWidget *propertiesWidget, con
 
     QFormLayout* layout = propertiesWidget->findChild<QFormLayout*>();
     layout->addRow(title, comboBox);
+
+    return comboBox;
 }
 
 PropertyEditorFactory::PropertyEditorFactory()
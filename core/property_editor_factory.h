@@ -4,6 +4,8 @@
 #include <QHash>
 #include <QObject>
 
+class QComboBox;
+
 namespace PropertyEditorFactoryUtils
 {
     QString convertCamelCaseToSpaces(const QString& input);
@@ -20,7 +22,7 @@ public:
     QWidget* createPropertyWidget(const QMetaProperty& property, QObject* propertyObject, QWidget* parent);
 
     QWidget* createPropertiesWidget(QObject *object, QWidget* parent = nullptr, const QStringList& hiddenProperties = {});
-    void addStringListComboBox(QWidget *propertiesWidget, const QStringList &values, const QString& title, QString &changedValue);
+    QComboBox* addStringListComboBox(QWidget *propertiesWidget, const QStringList &values, const QString& title, QString &changedValue, bool editable = false);
 
 private:
     PropertyEditorFactory();
@@ -0,0 +1,171 @@
+#include "roofline.h"
+#include "cache_control.h"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+    constexpr int ProbeRunsNum = 3;
+    constexpr qsizetype MinTriadArrayBytes = 16 * 1024 * 1024;
+    constexpr int ComputeProbeLength = 1 << 22;
+    constexpr int ComputeProbeChainsNum = 8;
+
+    ULONG64 getThreadCycles()
+    {
+        ULONG64 cycles;
+        QueryThreadCycleTime(GetCurrentThread(), &cycles);
+        return cycles;
+    }
+
+    // a[i] = b[i] + s * c[i] on arrays twice the size of the last level cache, counted as 24 bytes per element like STREAM
+    qreal measureTriadBytesPerCycle()
+    {
+        const qsizetype arrayBytes = std::max(2 * CacheControl::getLastLevelCacheSize(), MinTriadArrayBytes);
+        const qsizetype elementsNum = arrayBytes / sizeof(double);
+
+        std::unique_ptr<double[]> a(new double[elementsNum]);
+        std::unique_ptr<double[]> b(new double[elementsNum]);
+        std::unique_ptr<double[]> c(new double[elementsNum]);
+
+        std::fill_n(a.get(), elementsNum, 0.0);
+        std::fill_n(b.get(), elementsNum, 1.0);
+        std::fill_n(c.get(), elementsNum, 2.0);
+
+        const double scalar = 3.0;
+
+        ULONG64 bestCycles = ~0ull;
+        for(int run = 0; run < ProbeRunsNum; ++run)
+        {
+            const ULONG64 start = getThreadCycles();
+
+            for(qsizetype i = 0; i < elementsNum; ++i)
+            {
+                a[i] = b[i] + scalar * c[i];
+            }
+
+            const ULONG64 end = getThreadCycles();
+            bestCycles = std::min(bestCycles, end - start);
+        }
+
+        volatile double sink = a[elementsNum / 2];
+        (void)sink;
+
+        return static_cast<qreal>(3 * sizeof(double) * elementsNum) / std::max<ULONG64>(bestCycles, 1);
+    }
+
+    // independent chains, so the multipliers are kept busy instead of waiting for the previous result
+    qreal measureOperationsPerCycle()
+    {
+        ULONG64 bestCycles = ~0ull;
+        quint64 chains[ComputeProbeChainsNum];
+
+        // read from a volatile, so the compiler cannot compute the chains in advance and the probe measures real multiply-adds
+        volatile quint64 seed = 1;
+
+        for(int run = 0; run < ProbeRunsNum; ++run)
+        {
+            const quint64 firstValue = seed;
+            for(int chain = 0; chain < ComputeProbeChainsNum; ++chain)
+            {
+                chains[chain] = firstValue + chain;
+            }
+
+            const ULONG64 start = getThreadCycles();
+
+            for(int i = 0; i < ComputeProbeLength; ++i)
+            {
+                for(int chain = 0; chain < ComputeProbeChainsNum; ++chain)
+                {
+                    chains[chain] = chains[chain] * 6364136223846793005ull + 1442695040888963407ull;
+                }
+            }
+
+            volatile quint64 sink = chains[0] ^ chains[ComputeProbeChainsNum - 1];
+            (void)sink;
+
+            const ULONG64 end = getThreadCycles();
+            bestCycles = std::min(bestCycles, end - start);
+        }
+
+        return 2.0 * ComputeProbeLength * ComputeProbeChainsNum / std::max<ULONG64>(bestCycles, 1);
+    }
+
+    QString describeRate(qreal perCycle, const QString& unit, int baseMhz)
+    {
+        QString description = QString::number(perCycle, 'g', 3) + " " + unit + "/cycle";
+        if(baseMhz > 0)
+        {
+            description += " (" + QString::number(perCycle * baseMhz / 1000.0, 'g', 3) + " G" + unit + "/s)";
+        }
+
+        return description;
+    }
+}
+
+bool RooflineCeilings::isValid() const
+{
+    return bytesPerCycle > 0.0 && operationsPerCycle > 0.0;
+}
+
+QString RooflineCeilings::getDescription(int baseMhz) const
+{
+    return "triad " + describeRate(bytesPerCycle, "B", baseMhz) + ", peak " + describeRate(operationsPerCycle, "op", baseMhz);
+}
+
+qreal RooflinePoint::getBytesPerCycle() const
+{
+    return cycles > 0.0 ? bytes / cycles : 0.0;
+}
+
+qreal RooflinePoint::getOperationsPerCycle() const
+{
+    return cycles > 0.0 ? operations / cycles : 0.0;
+}
+
+qreal RooflinePoint::getIntensity() const
+{
+    return bytes > 0.0 ? operations / bytes : 0.0;
+}
+
+qreal RooflinePoint::getAttainableOperationsPerCycle(const RooflineCeilings &ceilings) const
+{
+    return std::min(ceilings.operationsPerCycle, getIntensity() * ceilings.bytesPerCycle);
+}
+
+QString RooflinePoint::getBound(const RooflineCeilings &ceilings) const
+{
+    return getIntensity() * ceilings.bytesPerCycle < ceilings.operationsPerCycle ? "memory" : "compute";
+}
+
+QString RooflinePoint::getDescription(const RooflineCeilings &ceilings, int baseMhz) const
+{
+    const qreal attainable = getAttainableOperationsPerCycle(ceilings);
+
+    QString description = "intensity " + QString::number(getIntensity(), 'g', 3) + " op/B, achieved " + describeRate(getBytesPerCycle(), "B", baseMhz)
+                          + " and " + describeRate(getOperationsPerCycle(), "op", baseMhz) + ", " + getBound(ceilings) + " bound";
+    if(attainable > 0.0)
+    {
+        description += ", " + QString::number(getOperationsPerCycle() / attainable * 100.0, 'f', 1) + "% of attainable";
+    }
+
+    return description;
+}
+
+namespace RooflineProbes
+{
+    const RooflineCeilings& getCeilings()
+    {
+        static const RooflineCeilings ceilings = []()
+        {
+            RooflineCeilings measuredCeilings;
+            measuredCeilings.bytesPerCycle = measureTriadBytesPerCycle();
+            measuredCeilings.operationsPerCycle = measureOperationsPerCycle();
+            return measuredCeilings;
+        }();
+
+        return ceilings;
+    }
+}
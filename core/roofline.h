@@ -0,0 +1,44 @@
+#ifndef ROOFLINE_H
+#define ROOFLINE_H
+
+#include <QString>
+
+// Machine ceilings in units of the benchmark cycle counter, measured once by the probes
+struct RooflineCeilings
+{
+    qreal bytesPerCycle = 0.0; // sustained memory bandwidth, STREAM triad
+    qreal operationsPerCycle = 0.0; // scalar integer operations, independent multiply-add chains
+
+    bool isValid() const;
+
+    // per second figures only when baseMhz is known, the cycle counter ticks at the nominal frequency
+    QString getDescription(int baseMhz) const;
+};
+
+// Achieved rates of one benchmark point placed under the ceilings
+struct RooflinePoint
+{
+    qreal bytes = 0.0;
+    qreal operations = 0.0;
+    qreal cycles = 0.0;
+
+    qreal getBytesPerCycle() const;
+    qreal getOperationsPerCycle() const;
+
+    qreal getIntensity() const;
+
+    // operations per cycle the ceilings allow at this intensity
+    qreal getAttainableOperationsPerCycle(const RooflineCeilings& ceilings) const;
+
+    // "memory" when the bandwidth ceiling is the lower one at this intensity, "compute" otherwise
+    QString getBound(const RooflineCeilings& ceilings) const;
+
+    QString getDescription(const RooflineCeilings& ceilings, int baseMhz) const;
+};
+
+namespace RooflineProbes
+{
+    const RooflineCeilings& getCeilings();
+}
+
+#endif // ROOFLINE_H
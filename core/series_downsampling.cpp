@@ -0,0 +1,70 @@
+#include "series_downsampling.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SeriesDownsamplingUtils
+{
+    QList<QPointF> largestTriangleThreeBuckets(const QList<QPointF>& points, int targetPointsNum)
+    {
+        const qsizetype pointsNum = points.size();
+        if(targetPointsNum < 3 || pointsNum <= targetPointsNum)
+        {
+            return points;
+        }
+
+        QList<QPointF> sampledPoints;
+        sampledPoints.reserve(targetPointsNum);
+        sampledPoints.append(points.first());
+
+        // the first and the last point are kept, the rest is split into targetPointsNum - 2 buckets
+        const qreal bucketSize = static_cast<qreal>(pointsNum - 2) / (targetPointsNum - 2);
+
+        qsizetype previousIndex = 0;
+
+        for(int bucket = 0; bucket < targetPointsNum - 2; ++bucket)
+        {
+            const qsizetype nextBucketStart = static_cast<qsizetype>(std::floor((bucket + 1) * bucketSize)) + 1;
+            const qsizetype nextBucketEnd = std::min(static_cast<qsizetype>(std::floor((bucket + 2) * bucketSize)) + 1, pointsNum);
+
+            qreal averageX = 0.0;
+            qreal averageY = 0.0;
+            for(qsizetype i = nextBucketStart; i < nextBucketEnd; ++i)
+            {
+                averageX += points[i].x();
+                averageY += points[i].y();
+            }
+
+            const qsizetype nextBucketPointsNum = std::max<qsizetype>(nextBucketEnd - nextBucketStart, 1);
+            averageX /= nextBucketPointsNum;
+            averageY /= nextBucketPointsNum;
+
+            const qsizetype bucketStart = static_cast<qsizetype>(std::floor(bucket * bucketSize)) + 1;
+            const qsizetype bucketEnd = nextBucketStart;
+
+            const QPointF& previousPoint = points[previousIndex];
+
+            qreal maxArea = -1.0;
+            qsizetype selectedIndex = bucketStart;
+
+            for(qsizetype i = bucketStart; i < bucketEnd; ++i)
+            {
+                // twice the triangle area, the factor does not change which point wins
+                const qreal area = std::abs((previousPoint.x() - averageX) * (points[i].y() - previousPoint.y())
+                                            - (previousPoint.x() - points[i].x()) * (averageY - previousPoint.y()));
+                if(area > maxArea)
+                {
+                    maxArea = area;
+                    selectedIndex = i;
+                }
+            }
+
+            sampledPoints.append(points[selectedIndex]);
+            previousIndex = selectedIndex;
+        }
+
+        sampledPoints.append(points.last());
+
+        return sampledPoints;
+    }
+}
@@ -0,0 +1,17 @@
+#ifndef SERIES_DOWNSAMPLING_H
+#define SERIES_DOWNSAMPLING_H
+
+#include <QList>
+#include <QPointF>
+
+namespace SeriesDownsamplingUtils
+{
+    /**
+     * Largest-Triangle-Three-Buckets decimation. Keeps the first and the last point and from every bucket
+     * the point spanning the largest triangle with the previously kept point and the average of the next bucket,
+     * so spikes survive. Points are taken in their order, returned unchanged when there are at most targetPointsNum.
+     */
+    QList<QPointF> largestTriangleThreeBuckets(const QList<QPointF>& points, int targetPointsNum);
+}
+
+#endif // SERIES_DOWNSAMPLING_H
@@ -0,0 +1,65 @@
+#include "thread_scaling.h"
+
+void ThreadScalingResults::append(int threadsNum, qreal wallTime, qreal work)
+{
+    threadsNums.append(threadsNum);
+    wallTimes.append(wallTime);
+    works.append(work);
+}
+
+bool ThreadScalingResults::isEmpty() const
+{
+    return threadsNums.isEmpty();
+}
+
+QList<QPointF> ThreadScalingResults::getSpeedup() const
+{
+    QList<QPointF> speedup;
+    if(isEmpty() || wallTimes.first() <= 0.0 || works.first() <= 0.0)
+    {
+        return speedup;
+    }
+
+    const qreal serialTimePerWork = wallTimes.first() / works.first();
+
+    speedup.reserve(threadsNums.size());
+    for(int i = 0; i < threadsNums.size(); ++i)
+    {
+        if(wallTimes[i] > 0.0)
+        {
+            speedup.append(QPointF(threadsNums[i], serialTimePerWork * works[i] / wallTimes[i]));
+        }
+    }
+
+    return speedup;
+}
+
+QList<QPointF> ThreadScalingResults::getEfficiency() const
+{
+    QList<QPointF> efficiency = getSpeedup();
+    for(QPointF& point : efficiency)
+    {
+        point.setY(point.y() / point.x());
+    }
+
+    return efficiency;
+}
+
+QList<QPointF> ThreadScalingResults::getKarpFlatt() const
+{
+    QList<QPointF> karpFlatt;
+
+    const QList<QPointF> speedup = getSpeedup();
+    for(const QPointF& point : speedup)
+    {
+        const qreal threadsNum = point.x();
+        if(threadsNum < 2.0 || point.y() <= 0.0)
+        {
+            continue;
+        }
+
+        karpFlatt.append(QPointF(threadsNum, (1.0 / point.y() - 1.0 / threadsNum) / (1.0 - 1.0 / threadsNum)));
+    }
+
+    return karpFlatt;
+}
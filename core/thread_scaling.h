@@ -0,0 +1,30 @@
+#ifndef THREAD_SCALING_H
+#define THREAD_SCALING_H
+
+#include <QList>
+#include <QPointF>
+
+/**
+ * Wall times of a parallel algorithm measured with a growing number of threads. For strong scaling the input is
+ * the same for every thread count, for weak scaling it grows with the threads. Every metric is normalized by the work,
+ * the selected complexity of the input, so a weak scaling run whose work does not grow linearly is still comparable.
+ */
+struct ThreadScalingResults
+{
+    QList<int> threadsNums;
+    QList<qreal> wallTimes; // milliseconds
+    QList<qreal> works;
+
+    void append(int threadsNum, qreal wallTime, qreal work);
+
+    bool isEmpty() const;
+
+    QList<QPointF> getSpeedup() const;
+
+    QList<QPointF> getEfficiency() const;
+
+    // experimentally determined serial fraction, from two threads on, a fraction growing with the threads points at overhead
+    QList<QPointF> getKarpFlatt() const;
+};
+
+#endif // THREAD_SCALING_H
@@ -3,6 +3,10 @@
 
 #include <QHash>
 #include <QList>
+#include <QRandomGenerator>
+
+#include <limits>
+#include <type_traits>
 
 #define INF 1e9
 
@@ -35,11 +39,19 @@ namespace Utils
             }
         }
     }
+
+    // generator of the benchmark inputs, one per thread, so a seeded benchmark never shares its sequence with another one
+    inline QRandomGenerator& getInputGenerator()
+    {
+        thread_local QRandomGenerator generator(QRandomGenerator::global()->generate());
+        return generator;
+    }
 }
 
 struct CompareByMinValue
 {
-    bool operator()(int a, int b) const
+    template<typename T>
+    bool operator()(const T& a, const T& b) const
     {
         return a > b;
     }
@@ -47,7 +59,8 @@ struct CompareByMinValue
 
 struct CompareByMaxValue
 {
-    bool operator()(int a, int b) const
+    template<typename T>
+    bool operator()(const T& a, const T& b) const
     {
         return a < b;
     }
@@ -347,4 +360,203 @@ private:
     QHash<int, int> keyIndices;
 };
 
+/**
+ * Indexed priority queue for keys from [0, keysNum), usually node indices. The heap position of every key lives in
+ * a dense array instead of a hash, so a lookup is a single load, and the sifts move a hole instead of swapping,
+ * so each level writes one entry and one position.
+ */
+template<typename Priority = int, typename Key = int, typename Compare = CompareByMinValue>
+class DenseIndexedPriorityQueue
+{
+    static_assert(std::is_integral_v<Key>, "keys index the position array");
+
+public:
+    using Entry = QPair<Key, Priority>;
+
+    explicit DenseIndexedPriorityQueue(qsizetype keysNum = 0)
+    {
+        reset(keysNum);
+    }
+
+    // empties the queue for keys from [0, keysNum), the buffers keep their capacity
+    void reset(qsizetype keysNum)
+    {
+        entries.clear();
+        entries.reserve(keysNum);
+        positions.fill(NoPosition, keysNum);
+    }
+
+    void release()
+    {
+        entries = QList<Entry>();
+        positions = QList<int>();
+    }
+
+    void insert(Key key, Priority priority)
+    {
+        Q_ASSERT(!contains(key));
+
+        entries.push_back({key, priority});
+        siftUp(static_cast<int>(entries.size()) - 1);
+    }
+
+    Entry extract()
+    {
+        Q_ASSERT(!entries.isEmpty());
+
+        const Entry entry = entries.first();
+        positions[entry.first] = NoPosition;
+
+        const Entry last = entries.takeLast();
+        if(!entries.isEmpty())
+        {
+            siftDown(0, last);
+        }
+
+        return entry;
+    }
+
+    const Entry& peek() const
+    {
+        Q_ASSERT(!entries.isEmpty());
+        return entries.first();
+    }
+
+    void deleteKey(Key key)
+    {
+        if(!contains(key))
+        {
+            return;
+        }
+
+        const int index = positions[key];
+        const Priority removedPriority = entries[index].second;
+        positions[key] = NoPosition;
+
+        const Entry last = entries.takeLast();
+        if(index < entries.size())
+        {
+            place(index, last);
+            restore(index, removedPriority, last.second);
+        }
+    }
+
+    void updateKey(Key key, Priority priority)
+    {
+        if(!contains(key))
+        {
+            insert(key, priority);
+            return;
+        }
+
+        const int index = positions[key];
+        const Priority oldPriority = entries[index].second;
+        if(oldPriority != priority)
+        {
+            entries[index].second = priority;
+            restore(index, oldPriority, priority);
+        }
+    }
+
+    bool contains(Key key) const
+    {
+        Q_ASSERT(key >= 0 && key < positions.size());
+        return positions[key] != NoPosition;
+    }
+
+    bool empty() const
+    {
+        return entries.empty();
+    }
+
+    qsizetype size() const
+    {
+        return entries.size();
+    }
+
+    // the largest priority when the key is not queued
+    Priority getValue(Key key) const
+    {
+        return contains(key) ? entries[positions[key]].second : std::numeric_limits<Priority>::max();
+    }
+
+private:
+    static constexpr int NoPosition = -1;
+
+    void place(int index, const Entry& entry)
+    {
+        entries[index] = entry;
+        positions[entry.first] = index;
+    }
+
+    void restore(int index, const Priority& oldPriority, const Priority& newPriority)
+    {
+        const Compare compare;
+        if(compare(oldPriority, newPriority))
+        {
+            siftUp(index);
+        }
+        else if(compare(newPriority, oldPriority))
+        {
+            siftDown(index, entries[index]);
+        }
+    }
+
+    void siftUp(int index)
+    {
+        const Entry entry = entries[index];
+
+        const Compare compare;
+        while(index > 0)
+        {
+            const int parent = HeapHelpers::getParent(index);
+            if(!compare(entries[parent].second, entry.second))
+            {
+                break;
+            }
+
+            place(index, entries[parent]);
+            index = parent;
+        }
+
+        place(index, entry);
+    }
+
+    // entry goes to index or below it, whatever entries[index] holds is overwritten
+    void siftDown(int index, const Entry entry)
+    {
+        const int entriesNum = static_cast<int>(entries.size());
+
+        const Compare compare;
+        while(true)
+        {
+            int child = HeapHelpers::getLeftChild(index);
+            if(child >= entriesNum)
+            {
+                break;
+            }
+
+            const int rightChild = child + 1;
+            if(rightChild < entriesNum && compare(entries[child].second, entries[rightChild].second))
+            {
+                child = rightChild;
+            }
+
+            if(!compare(entry.second, entries[child].second))
+            {
+                break;
+            }
+
+            place(index, entries[child]);
+            index = child;
+        }
+
+        place(index, entry);
+    }
+
+private:
+    QList<Entry> entries;
+    QList<int> positions; // heap index of every key, NoPosition when the key is not queued
+};
+
 #endif // UTILS_H
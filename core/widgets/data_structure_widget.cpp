@@ -1,4 +1,5 @@
 #include "data_structure_widget.h"
+#include "../benchmark_trace.h"
 
 #include <QMouseEvent>
 #include <QPainter>
@@ -41,6 +42,8 @@ const QList<QWidget *> &DataStructureWidget::getAdditionalToolBarWidget() const
 
 void DataStructureWidget::paintEvent(QPaintEvent *event)
 {
+    TraceScope traceScope("paint", "visualizer");
+
     QPen nodePen;
     nodePen.setBrush(Qt::black);
     nodePen.setWidth(2);
@@ -26,10 +26,10 @@ void Graph::generateRandomEdges(const double addEdgePropability, const int minWe
         {
             if(i != j && !hasEdgeTo(i, j))
             {
-                const double randomDouble = QRandomGenerator::global()->generateDouble();
+                const double randomDouble = Utils::getInputGenerator().generateDouble();
                 if(randomDouble < addEdgePropability)
                 {
-                    addEdge(i, j, QRandomGenerator::global()->bounded(minWeight, maxWeight + 1));
+                    addEdge(i, j, Utils::getInputGenerator().bounded(minWeight, maxWeight + 1));
                 }
             }
         };
@@ -118,6 +118,23 @@ bool Graph::getIsDirected() const
     return isDirected;
 }
 
+void Graph::copyFrom(const Graph &source)
+{
+    const qsizetype sourceNodesNum = source.getNodesNum();
+    for(qsizetype i = 0; i < sourceNodesNum; ++i)
+    {
+        addNode();
+    }
+
+    auto copyEdge = [this](int from, int to, int weight)
+    {
+        addEdge(from, to, weight);
+        return true;
+    };
+
+    source.forEachEdge(copyEdge);
+}
+
 void Graph::setIsDirected(bool newIsDirected)
 {
     isDirected = newIsDirected;
@@ -378,6 +395,21 @@ int AdjacencyListGraph::getNeighbourAt(int node, int at) const
     return adjList[node][at].endValue;
 }
 
+Graph *AdjacencyListGraph::createEmptyGraph() const
+{
+    return new AdjacencyListGraph(nullptr, isDirected);
+}
+
+qsizetype AdjacencyListGraph::getNodeScanBytes() const
+{
+    return sizeof(Neighbours);
+}
+
+qsizetype AdjacencyListGraph::getEdgeScanBytes() const
+{
+    return sizeof(Edge);
+}
+
 AdjacencyMatrixGraph::AdjacencyMatrixGraph(QObject *parent, bool inIsDirected, int nodes)
     : Graph(parent, inIsDirected)
 {
@@ -509,7 +541,7 @@ void AdjacencyMatrixGraph::forEachEdge(std::function<bool (int, int, int)> func)
 {
     for(int i = 0; i < adjMatrix.size(); ++i)
     {
-        for(int j = 0; i < adjMatrix[i].size(); ++i)
+        for(int j = 0; j < adjMatrix[i].size(); ++j)
         {
             if(adjMatrix[i][j] != INF)
             {
@@ -552,11 +584,42 @@ qsizetype AdjacencyMatrixGraph::getNeighboursNum(int node) const
 
 int AdjacencyMatrixGraph::getNeighbourAt(int node, int at) const
 {
-    if(adjMatrix.size() <= node && adjMatrix[node].size() <= at)
+    if(adjMatrix.size() <= node)
     {
         return -1;
     }
-    return adjMatrix[node][at];
+
+    // a row holds weights, the at-th neighbour is the at-th column with an edge
+    int neighboursSeen = 0;
+    for(int i = 0; i < adjMatrix[node].size(); ++i)
+    {
+        if(adjMatrix[node][i] != INF)
+        {
+            if(neighboursSeen == at)
+            {
+                return i;
+            }
+            neighboursSeen++;
+        }
+    }
+
+    return -1;
+}
+
+Graph *AdjacencyMatrixGraph::createEmptyGraph() const
+{
+    return new AdjacencyMatrixGraph(nullptr, isDirected);
+}
+
+qsizetype AdjacencyMatrixGraph::getNodeScanBytes() const
+{
+    // the whole row is read whatever the number of neighbours
+    return sizeof(Neighbours) + adjMatrix.size() * sizeof(int);
+}
+
+qsizetype AdjacencyMatrixGraph::getEdgeScanBytes() const
+{
+    return 0;
 }
 
 ResidualGraph::ResidualGraph(QObject *parent)
@@ -729,6 +792,33 @@ int ResidualGraph::getNeighbourAt(int node, int at) const
     return adjList[node][at]->to;
 }
 
+Graph *ResidualGraph::createEmptyGraph() const
+{
+    return new ResidualGraph;
+}
+
+qsizetype ResidualGraph::getNodeScanBytes() const
+{
+    return sizeof(Neighbours);
+}
+
+qsizetype ResidualGraph::getEdgeScanBytes() const
+{
+    // the pointer and the edge it points to
+    return sizeof(QSharedPointer<Edge>) + sizeof(Edge);
+}
+
+void ResidualGraph::resetFlows()
+{
+    for(const auto& neighbours : adjList)
+    {
+        for(const auto& edge : neighbours)
+        {
+            edge->flow = 0;
+        }
+    }
+}
+
 const ResidualGraph::GraphContainer &ResidualGraph::getGraphContainer() const
 {
     return adjList;
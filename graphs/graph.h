@@ -18,6 +18,9 @@ public:
     QJsonObject toJsonObject();
     void fromJsonObject(const QJsonObject& jsonObject);
 
+    // adds all nodes and edges of source, used to put one input into different representations
+    void copyFrom(const Graph& source);
+
 #ifdef QT_DEBUG
     void print() const override;
 #endif
@@ -35,8 +38,17 @@ public:
     virtual void clear() = 0;
     virtual int getRandomValue(bool* found = nullptr) const = 0;
     virtual qsizetype getNeighboursNum(int node) const = 0;
+
+    // the at-th neighbour in forEachNeighbour order or -1, constant time for the lists, a scan of the row for the matrix
     virtual int getNeighbourAt(int node, int at) const = 0;
 
+    // a graph of the same representation and direction without nodes, owned by the caller
+    virtual Graph* createEmptyGraph() const = 0;
+
+    // estimated bytes read by forEachNeighbour before the first neighbour and for every neighbour, used by the roofline report
+    virtual qsizetype getNodeScanBytes() const = 0;
+    virtual qsizetype getEdgeScanBytes() const = 0;
+
     /** if func returns false, next edge will not be processed, forEachEdge is supposed to end execution too */
     virtual void forEachEdge(std::function<bool(int, int, int)> func) = 0;
 
@@ -80,6 +92,9 @@ public:
     void forEachNeighbour(int node, std::function<bool(int, int, int)> func) override;
     qsizetype getNeighboursNum(int node) const override;
     int getNeighbourAt(int node, int at) const override;
+    Graph* createEmptyGraph() const override;
+    qsizetype getNodeScanBytes() const override;
+    qsizetype getEdgeScanBytes() const override;
 
 private:
     struct Edge
@@ -120,6 +135,9 @@ public:
     void forEachNeighbour(int node, std::function<bool(int, int, int)> func) override;
     qsizetype getNeighboursNum(int node) const override;
     int getNeighbourAt(int node, int at) const override;
+    Graph* createEmptyGraph() const override;
+    qsizetype getNodeScanBytes() const override;
+    qsizetype getEdgeScanBytes() const override;
 
 private:
     using Neighbours = QList<int>;
@@ -147,6 +165,11 @@ public:
     void forEachNeighbour(int node, std::function<bool(int, int, int)> func) override;
     qsizetype getNeighboursNum(int node) const override;
     int getNeighbourAt(int node, int at) const override;
+    Graph* createEmptyGraph() const override;
+    qsizetype getNodeScanBytes() const override;
+    qsizetype getEdgeScanBytes() const override;
+
+    void resetFlows();
 
     struct Edge
     {
@@ -2,6 +2,12 @@
 #include "graph_algorithms.h"
 #include "graph.h"
 
+#include "../core/algorithm_texts.h"
+#include "../core/allocation_tracker.h"
+#include "../core/cache_control.h"
+#include "../core/execution_environment.h"
+#include "../core/roofline.h"
+#include "../core/thread_scaling.h"
 #include "../core/property_editor_factory.h"
 #include "../core/utils.h"
 #include "../core/benchmark_timers.h"
@@ -16,165 +22,1188 @@
 #include <QComboBox>
 #include <QElapsedTimer>
 #include <QFormLayout>
+#include <QJsonArray>
 #include <QLabel>
+#include <QMetaProperty>
 #include <QRandomGenerator>
+#include <QSharedPointer>
 #include <QStack>
 #include <QWidget>
 
+#include <atomic>
+#include <barrier>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace ValidationGroups
+{
+    inline const QString ShortestPath = "shortest path from the first to the last node";
+    inline const QString MaxFlow = "max flow from the first to the last node";
+    inline const QString TopologicalOrder = "topological order";
+    inline const QString TravelingSalesman = "traveling salesman tour cost";
+}
+
+namespace
+{
+    // new instances owned by the caller
+    QList<GraphAlgorithm*> createValidationGroup(const QString& validationGroup)
+    {
+        if(validationGroup == ValidationGroups::ShortestPath)
+        {
+            return {new LazyDijkstraAlgorithm(), new EagerDijkstraAlgorithm(), new BellmanFordAlgorithm()};
+        }
+
+        if(validationGroup == ValidationGroups::MaxFlow)
+        {
+            return {new MaxNetworkFlowFordFulkersonAlgorithm(), new MaxNetworkFlowEdmondsKarpAlgorithm(),
+                    new MaxNetworkFlowCapacityScalingAlgorithm(), new MaxNetworkFlowDinicAlgorithm()};
+        }
+
+        if(validationGroup == ValidationGroups::TopologicalOrder)
+        {
+            return {new TopologicalSort(), new KahnsAlgorithm()};
+        }
+
+        if(validationGroup == ValidationGroups::TravelingSalesman)
+        {
+            return {new TravelingSalesmanProblemAlgorithmHash(), new TravelingSalesmanProblemAlgorithmBitmask()};
+        }
+
+        return {};
+    }
+
+    // number of nodes when order is a topological order of the whole graph, -1 otherwise, a cycle included
+    qint64 getTopologicalOrderValue(const Graph* graph, const QList<int>& order)
+    {
+        const qsizetype nodesNum = graph->getNodesNum();
+        if(order.size() != nodesNum)
+        {
+            return -1;
+        }
+
+        QList<int> positions(nodesNum, -1);
+        for(int i = 0; i < order.size(); ++i)
+        {
+            positions[order[i]] = i;
+        }
+
+        bool isValid = true;
+        graph->forEachEdge([&](int start, int end, int weight)
+        {
+            isValid = positions[start] < positions[end];
+            return isValid;
+        });
+
+        return isValid ? nodesNum : -1;
+    }
+
+    // sum of the edge weights along the tour, -1 when there is no tour
+    qint64 getTourCost(const Graph* graph, const QList<int>& tour)
+    {
+        if(tour.size() < 2)
+        {
+            return -1;
+        }
+
+        qint64 cost = 0;
+        for(int i = 1; i < tour.size(); ++i)
+        {
+            cost += graph->getEdgeWeight(tour[i - 1], tour[i]);
+        }
+
+        return cost;
+    }
+
+    // entries of the representation, an undirected edge is stored in both directions
+    qreal getStoredEdgesNum(const Graph* graph)
+    {
+        return static_cast<qreal>(graph->getEdgesNum()) * (graph->getIsDirected() ? 1 : 2);
+    }
+
+    void estimateBreadthFirstTraffic(const Graph* graph, qint64 reachedNodesNum, qreal& outBytes, qreal& outOperations)
+    {
+        const qsizetype nodesNum = graph->getNodesNum();
+        const qreal scannedEdgesNum = nodesNum > 0 ? getStoredEdgesNum(graph) * reachedNodesNum / nodesNum : 0.0;
+
+        outBytes = reachedNodesNum * (graph->getNodeScanBytes() + 2 * sizeof(int))
+                   + scannedEdgesNum * (graph->getEdgeScanBytes() + sizeof(bool));
+        outOperations = reachedNodesNum + scannedEdgesNum;
+    }
+}
+
+GraphSweepTotals::GraphSweepTotals(int representationsNum)
+    : measuredCycles(representationsNum, 0.0)
+    , resultChecksums(representationsNum, 0)
+{
+
+}
+
+QJsonObject GraphSweepTotals::toJsonObject() const
+{
+    QJsonArray measuredCyclesAsJsonArray;
+    QJsonArray resultChecksumsAsJsonArray;
+    for(int r = 0; r < measuredCycles.size(); ++r)
+    {
+        measuredCyclesAsJsonArray.append(measuredCycles[r]);
+        // as a string, a double cannot hold every 64-bit hash
+        resultChecksumsAsJsonArray.append(QString::number(resultChecksums[r], 16));
+    }
+
+    QJsonObject jsonObject;
+    jsonObject["buildCycles"] = buildCycles;
+    jsonObject["measuredCycles"] = measuredCyclesAsJsonArray;
+    jsonObject["resultChecksums"] = resultChecksumsAsJsonArray;
+    jsonObject["validationMismatches"] = QJsonArray::fromStringList(validationMismatches);
+
+    return jsonObject;
+}
+
+GraphSweepTotals GraphSweepTotals::fromJsonObject(const QJsonObject &jsonObject, int representationsNum)
+{
+    const QJsonArray measuredCyclesAsJsonArray = jsonObject["measuredCycles"].toArray();
+    const QJsonArray resultChecksumsAsJsonArray = jsonObject["resultChecksums"].toArray();
+
+    GraphSweepTotals totals(representationsNum);
+    totals.buildCycles = jsonObject["buildCycles"].toDouble();
+
+    for(int r = 0; r < representationsNum; ++r)
+    {
+        totals.measuredCycles[r] = measuredCyclesAsJsonArray[r].toDouble();
+        totals.resultChecksums[r] = resultChecksumsAsJsonArray[r].toString().toULongLong(nullptr, 16);
+    }
+
+    totals.validationMismatches = jsonObject["validationMismatches"].toVariant().toStringList();
+
+    return totals;
+}
+
 GraphAlgorithm::GraphAlgorithm(QObject *parent)
     : Algorithm(parent)
     , graph(nullptr)
+    , resultValue(0)
+    , regenerateGraphPerRepetition(false)
+    , compareRepresentations(false)
+    , validateResults(false)
+    , currentX(0.0)
+    , executeTraceName("execute")
+    , builderCore(0)
+    , executionCore(0)
     , builderPropertiesWidget(nullptr)
 {
-    complexityList.push_back(qMakePair("O(1)",                [](int I, int V, int E) { return I; }));
-    complexityList.push_back(qMakePair("O(V)",                [](int I, int V, int E) { return V; }));
-    complexityList.push_back(qMakePair("O(E)",                [](int I, int V, int E) { return E; }));
-    complexityList.push_back(qMakePair("O(V+E)",              [](int I, int V, int E) { return V+E; }));
-    complexityList.push_back(qMakePair("O(2*V+E)",            [](int I, int V, int E) { return 2*V+E; }));
-    complexityList.push_back(qMakePair("O(V^2)",              [](int I, int V, int E) { return V*V; }));
-    complexityList.push_back(qMakePair("O(V+E)*logV",         [](int I, int V, int E) { return (V+E)*std::log(V); }));
-    complexityList.push_back(qMakePair("O(V*E)",              [](int I, int V, int E) { return (V*E); }));
-    complexityList.push_back(qMakePair("O(V^3)",              [](int I, int V, int E) { return (V*V*V); }));
-    complexityList.push_back(qMakePair("O(V*(E+1))",          [](int I, int V, int E) { return V*(E+1); }));
-    complexityList.push_back(qMakePair("O(V^2*2^V)",          [](int I, int V, int E) { return V*V*(1<<V); }));
-    complexityList.push_back(qMakePair("O(E*log(E))",         [](int I, int V, int E) { return E * std::log(E); }));
-    complexityList.push_back(qMakePair("O(E*log(V))",         [](int I, int V, int E) { return E * std::log(V); }));
-    complexityList.push_back(qMakePair("O(log(E))",           [](int I, int V, int E) { return std::log(E); }));
-    complexityList.push_back(qMakePair("O(log(V))",           [](int I, int V, int E) { return std::log(V); }));
-    complexityList.push_back(qMakePair("O((V+E)*log(V+E))",   [](int I, int V, int E) { return (V+E)*std::log(V+E); }));
-    complexityList.push_back(qMakePair("O(V*log(V))",         [](int I, int V, int E) { return V*std::log(V); }));
-    complexityList.push_back(qMakePair("O(E*I)",              [](int I, int V, int E) { return E*I; }));
-    complexityList.push_back(qMakePair("O(V*E^2)",              [](int I, int V, int E) { return V*E*E; }));
-    complexityList.push_back(qMakePair("O(V^2*E)",              [](int I, int V, int E) { return V*V*E; }));
-    complexityList.push_back(qMakePair("O(√V*E)",              [](int I, int V, int E) { return std::sqrt(V*E); }));
+    addComplexity("O(1)",                "I");
+    addComplexity("O(V)",                "V");
+    addComplexity("O(E)",                "E");
+    addComplexity("O(V+E)",              "V+E");
+    addComplexity("O(2*V+E)",            "2*V+E");
+    addComplexity("O(V^2)",              "V^2");
+    addComplexity("O(V+E)*logV",         "(V+E)*log(V)");
+    addComplexity("O(V*E)",              "V*E");
+    addComplexity("O(V^3)",              "V^3");
+    addComplexity("O(V*(E+1))",          "V*(E+1)");
+    addComplexity("O(V^2*2^V)",          "V^2*2^V");
+    addComplexity("O(E*log(E))",         "E*log(E)");
+    addComplexity("O(E*log(V))",         "E*log(V)");
+    addComplexity("O(log(E))",           "log(E)");
+    addComplexity("O(log(V))",           "log(V)");
+    addComplexity("O((V+E)*log(V+E))",   "(V+E)*log(V+E)");
+    addComplexity("O(V*log(V))",         "V*log(V)");
+    addComplexity("O(E*I)",              "E*I");
+    addComplexity("O(V*E^2)",            "V*E^2");
+    addComplexity("O(V^2*E)",            "V^2*E");
+    addComplexity("O(√V*E)",             "sqrt(V)*E");
+    addComplexity("O(E*log2(Wmax))",     "E*log2(Wmax)");
+
+    dataStructureBuilders.push_back(new GeneralGraphBuilder(this));
+    dataStructureBuilders.push_back(new GridGraphBuilder(this));
+    dataStructureBuilders.push_back(new TreeGraphBuilder(this));
+}
+
+GraphAlgorithm::~GraphAlgorithm()
+{
+
+}
+
+QWidget *GraphAlgorithm::createPropertiesWidget(QWidget *parent)
+{
+    builderPropertiesWidget = nullptr;
+
+    QWidget* propertiesWidget = Algorithm::createPropertiesWidget(parent);
+
+    QVBoxLayout* verticalLayout = qobject_cast<QVBoxLayout*>(propertiesWidget->layout());
+    QFormLayout* formLayout = propertiesWidget->findChild<QFormLayout*>();
+
+    QComboBox* builderComboBox = new QComboBox(propertiesWidget);
+    builderComboBox->addItems(getBuilderNames());
+    builderComboBox->setCurrentText(getSelectedBuilder()->objectName());
+
+    formLayout->addRow("builder", builderComboBox);
+
+    auto onBuilderSelected = [this, verticalLayout, parent](const QString& currentText)
+    {
+        selectBuilder(currentText);
+
+        if(builderPropertiesWidget)
+        {
+            verticalLayout->removeWidget(builderPropertiesWidget);
+            builderPropertiesWidget->deleteLater();
+            builderPropertiesWidget = nullptr;
+        }
+
+        PropertyEditorFactory& propertyEditorFactory = PropertyEditorFactory::get();
+
+        builderPropertiesWidget = getSelectedBuilder()->createPropertiesWidget(parent);
+
+        verticalLayout->addWidget(builderPropertiesWidget);
+    };
+
+    connect(builderComboBox, &QComboBox::currentTextChanged, this, onBuilderSelected);
+
+    onBuilderSelected(builderComboBox->currentText());
+
+    return propertiesWidget;
+}
+
+void GraphAlgorithm::appendPropertiesInfo(QString &infoText)
+{
+    Algorithm::appendPropertiesInfo(infoText);
+
+    infoText.append("builder : " + getSelectedBuilder()->objectName());
+    infoText.append("\n");
+}
+
+void GraphAlgorithm::run()
+{
+    if(threadScaling)
+    {
+        runThreadScaling();
+        return;
+    }
+
+    cancellationToken.reset();
+
+    BenchmarkTimerRecorder& timerRecorder = BenchmarkTimerRecorder::getThreadRecorder();
+    timerRecorder.reset();
+
+    GraphBuilder* graphBuilder = qobject_cast<GraphBuilder*>(getSelectedBuilder());
+    const QString& selectedImplementation = graphBuilder->getSelectedImplementation();
+
+    const QStringList representations = compareRepresentations ? graphBuilder->getImplementations() : QStringList{selectedImplementation};
+
+    AlgorithmBenchmarkResult baseResultData;
+    appendPropertiesInfo(baseResultData.toolTipInfo);
+    graphBuilder->appendPropertiesInfo(baseResultData.toolTipInfo);
+
+    ThreadAffinityGuard affinityGuard;
+    ThreadPriorityGuard priorityGuard;
+    setUpExecutionEnvironment(affinityGuard, priorityGuard, baseResultData.runInfo, baseResultData.toolTipInfo);
+
+    currentComplexity = getSelectedComplexity();
+
+    BenchmarkCheckpoint checkpoint;
+    std::swap(checkpoint, resumeCheckpoint);
+
+    const bool resumed = checkpoint.results.size() == representations.size();
+
+    const QString startTime = resumed ? checkpoint.results.first().runInfo.startTime : QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
+
+    setUpRunInfo(baseResultData.runInfo, graphBuilder, startTime);
+
+    // every point reseeds the input generator from this seed and its iteration, so a resumed sweep rebuilds the same graphs
+    const quint64 inputSeed = resumed ? checkpoint.inputSeed : QRandomGenerator::global()->generate64();
+    baseResultData.toolTipInfo.append("input seed : " + QString::number(inputSeed));
+    baseResultData.toolTipInfo.append("\n");
+
+    QList<AlgorithmBenchmarkResult> results = resumed ? restoreSweepResults(checkpoint, representations) : createSweepResults(baseResultData, representations);
+
+    QList<GraphAlgorithm*> equivalentAlgorithms;
+    QStringList skippedEquivalents;
+    if(validateResults)
+    {
+        equivalentAlgorithms = createEquivalentAlgorithms(skippedEquivalents);
+    }
+
+    QList<RooflinePoint> lastRooflinePoints(representations.size());
+
+    currentCacheMode = selectedCacheMode;
+
+    if(currentCacheMode == CacheModes::OtherCore)
+    {
+        const QList<int> cores = CacheControl::getAvailableCores();
+        executionCore = pinnedCore >= 0 ? pinnedCore : cores.last();
+        builderCore = cores.first() != executionCore ? cores.first() : cores.last();
+    }
+
+    ThrottlingDetector throttlingDetector;
+    if(detectThrottling)
+    {
+        throttlingDetector.calibrate();
+    }
+
+    emit started();
+
+    executeTraceName = recordTrace ? TraceRecorder::internName(objectName() + " execute") : "execute";
+    startTrace();
+
+    const int repetitions = std::max(1, repetitionsNumber);
+    const int graphsNum = regenerateGraphPerRepetition ? repetitions : 1;
+
+    takePartialResults();
+    partialResultsTimer.start();
+
+    BenchmarkPartialResults pendingResults;
+    QElapsedTimer pointTimer;
+
+    GraphSweepTotals totals = resumed ? GraphSweepTotals::fromJsonObject(checkpoint.sweepState["totals"].toObject(), representations.size())
+                                      : GraphSweepTotals(representations.size());
+
+    int i = 0;
+
+    if(resumed)
+    {
+        i = checkpoint.nextIteration;
+
+        pendingResults.points = results.first().mainSeries;
+        publishPartialResults(pendingResults, i, true);
+    }
+
+    QString checkpointInfo;
+    QElapsedTimer checkpointTimer;
+    checkpointTimer.start();
+
+    QString truncationInfo;
+    int truncatedRepresentation = -1;
+    QPointF truncatedPoint; // the cycles until the kernel gave up, a lower bound of the point
+    bool truncatedInMeasuredRun = false;
+
+    for(; i < iterationsNumber; ++i)
+    {
+        if(cancellationToken.isCancelled())
+        {
+            break;
+        }
+
+        pointTimer.start();
+
+        graphBuilder->buildIterations = i + 1;
+        currentIteration = i;
+
+        std::seed_seq pointSeed{static_cast<quint32>(inputSeed), static_cast<quint32>(inputSeed >> 32), static_cast<quint32>(i)};
+        Utils::getInputGenerator().seed(pointSeed);
+
+        if(currentCacheMode == CacheModes::OtherCore)
+        {
+            affinityGuard.moveTo(builderCore);
+        }
+
+        QList<QSharedPointer<Graph>> testGraphs;
+        qreal pointBuildCycles = 0.0;
+        ComplexityVariables pointInput = buildPointGraphs(graphBuilder, graphsNum, testGraphs, pointBuildCycles);
+
+        currentInput = pointInput;
+        currentX = currentComplexity.evaluate(pointInput);
+
+        const GraphSweepTotals pointStartTotals = totals;
+        totals.buildCycles += pointBuildCycles;
+
+        for(int r = 0; r < representations.size(); ++r)
+        {
+            AlgorithmBenchmarkResult& resultData = results[r];
+
+            const QList<QSharedPointer<Graph>> representationGraphs = representations[r] == selectedImplementation
+                                                                      ? testGraphs : convertGraphs(graphBuilder, testGraphs, representations[r]);
+
+            const BenchmarkStatistics statistics = measurePoint(representationGraphs, resultData, affinityGuard);
+            pointInput = currentInput;
+
+            if(cancellationToken.isTruncated())
+            {
+                truncatedRepresentation = r;
+                truncatedPoint = QPointF(currentX, statistics.median);
+                truncatedInMeasuredRun = statistics.samplesNum > 0;
+                break;
+            }
+
+            totals.measuredCycles[r] += statistics.median;
+
+            // the result of the last measured run is still in place
+            totals.resultChecksums[r] = qHashMulti(totals.resultChecksums[r], getResultChecksum());
+
+            appendRooflinePoints(resultData, representationGraphs.first().get(), statistics, lastRooflinePoints[r]);
+
+            if(r == 0 && validateResults)
+            {
+                validatePoint(representationGraphs.first().get(), equivalentAlgorithms, totals.validationMismatches);
+            }
+
+            if(!buildsOwnInput())
+            {
+                SubSeriesData& buildData = resultData["graph construction"];
+                buildData.color = Qt::darkGray;
+                buildData.points.append(QPointF(currentX, pointBuildCycles));
+            }
+
+            resultData.mainSeries.append(QPointF(currentX, statistics.median));
+            resultData.mainSeriesStatistics.append(statistics);
+            resultData.mainSeriesInputs.append(pointInput);
+        }
+
+        if(truncatedRepresentation >= 0)
+        {
+            takeBackPoint(results, truncatedRepresentation);
+            totals = pointStartTotals;
+
+            const QString reason = cancellationToken.isOverBudget() ? "over the budget of " + QString::number(iterationTimeBudget) + " ms" : QString("cancelled");
+            truncationInfo = "truncated : iteration " + QString::number(i) + " at x = " + QString::number(currentX, 'g', 6)
+                             + (compareRepresentations ? " (" + representations[truncatedRepresentation] + ")" : QString()) + ", " + reason
+                             + (truncatedInMeasuredRun ? QString() : QString(" before a measured run")) + "\n";
+            break;
+        }
+
+        if(detectThrottling)
+        {
+            throttlingDetector.check(currentX);
+        }
+
+        pendingResults.points.append(results.first().mainSeries.last());
+        pendingResults.pointWallTimes.append(pointTimer.nsecsElapsed() / 1e6);
+        publishPartialResults(pendingResults, i + 1);
+
+        if(checkpointInterval > 0 && checkpointTimer.elapsed() >= checkpointInterval * 1000ll)
+        {
+            checkpointInfo = saveCheckpoint(results, inputSeed, i + 1, totals);
+            checkpointTimer.restart();
+        }
+    }
+
+    publishPartialResults(pendingResults, i, true);
+
+    // a sweep stopped by the budget would stop again when resumed
+    const bool stoppedByBudget = truncatedRepresentation >= 0 && cancellationToken.isOverBudget();
+    if(i < iterationsNumber && !stoppedByBudget)
+    {
+        checkpointInfo = saveCheckpoint(results, inputSeed, i, totals);
+    }
+    else
+    {
+        BenchmarkCheckpoint::remove(BenchmarkCheckpoint::getFilePath(objectName()));
+        checkpointInfo.clear();
+    }
+
+    // added after the checkpoint was saved, a resumed sweep measures the point again
+    if(truncatedInMeasuredRun)
+    {
+        SubSeriesData& truncatedData = results[truncatedRepresentation]["truncated"];
+        truncatedData.color = Qt::red;
+        truncatedData.points.append(truncatedPoint);
+    }
+
+    qDeleteAll(equivalentAlgorithms);
+
+    graph = nullptr;
+    currentIteration = 0;
+
+    releaseScratchMemory();
+
+    const QString endTime = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
+
+    QString traceInfo;
+    finishTrace(traceInfo);
+
+    QString throttlingInfo;
+    if(detectThrottling)
+    {
+        const QString throttlingDescription = throttlingDetector.getDescription();
+        throttlingInfo = "throttling : " + (throttlingDescription.isEmpty() ? QString("not detected") : throttlingDescription) + "\n";
+    }
+
+    for(int r = 0; r < results.size(); ++r)
+    {
+        AlgorithmBenchmarkResult& resultData = results[r];
+        QString& toolTipText = resultData.toolTipInfo;
+
+        toolTipText.append("build iterations : " + QString::number(i));
+        toolTipText.append("\n");
+
+        if(totals.buildCycles > 0.0 && totals.measuredCycles[r] > 0.0)
+        {
+            toolTipText.append("construction / measured time : " + QString::number(totals.buildCycles / totals.measuredCycles[r], 'f', 2));
+            toolTipText.append("\n");
+        }
+
+        toolTipText.append("start time : " + startTime);
+        toolTipText.append("\n");
+
+        resultData.runInfo.endTime = endTime;
+
+        toolTipText.append("end time : " + endTime);
+        toolTipText.append("\n");
+
+        toolTipText.append(traceInfo);
+        toolTipText.append(throttlingInfo);
+        toolTipText.append(checkpointInfo);
+        toolTipText.append(truncationInfo);
+
+        appendRooflineInfo(resultData, lastRooflinePoints[r]);
+
+        toolTipText.append("result checksum : " + QString::number(totals.resultChecksums[r], 16));
+        toolTipText.append("\n");
+
+        if(validateResults)
+        {
+            appendValidationInfo(toolTipText, totals.validationMismatches, skippedEquivalents, i);
+        }
+
+        appendCountersInfo(resultData, toolTipText);
+
+        analyzeComplexity(resultData);
+        resultData.complexityAnalysis.appendInfo(toolTipText);
+
+        emit finished(resultData);
+    }
+}
+
+void GraphAlgorithm::runThreadScaling()
+{
+    cancellationToken.reset();
+
+    GraphBuilder* graphBuilder = qobject_cast<GraphBuilder*>(getSelectedBuilder());
+
+    AlgorithmBenchmarkResult baseResultData;
+    appendPropertiesInfo(baseResultData.toolTipInfo);
+    graphBuilder->appendPropertiesInfo(baseResultData.toolTipInfo);
+
+    ThreadAffinityGuard affinityGuard;
+    ThreadPriorityGuard priorityGuard;
+    setUpExecutionEnvironment(affinityGuard, priorityGuard, baseResultData.runInfo, baseResultData.toolTipInfo);
+
+    currentComplexity = getSelectedComplexity();
+
+    const QString startTime = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
+    setUpRunInfo(baseResultData.runInfo, graphBuilder, startTime);
+
+    emit started();
+
+    startTrace();
+
+    const int weakScalingIterations = std::max(1, iterationsNumber / maxThreadsNumber);
+
+    ThreadScalingResults strongScaling;
+    ThreadScalingResults weakScaling;
+
+    auto buildGraph = [&](int buildIterations, qreal& outWork)
+    {
+        graphBuilder->buildIterations = buildIterations;
+
+        QSharedPointer<Graph> testGraph(dynamic_cast<Graph*>(graphBuilder->createDataStructure()));
+
+        ComplexityVariables input;
+        input.iteration = buildIterations - 1;
+        input.nodesNum = testGraph->getNodesNum();
+        input.edgesNum = testGraph->getEdgesNum();
+        input.minWeight = graphBuilder->getMinWeight();
+        input.maxWeight = graphBuilder->getMaxWeight();
+
+        outWork = currentComplexity.evaluate(input);
+
+        return testGraph;
+    };
+
+    qreal strongScalingWork = 0.0;
+    const QSharedPointer<Graph> strongScalingGraph = buildGraph(iterationsNumber, strongScalingWork);
+
+    QString truncationInfo;
+
+    for(int threadsNum = 1; threadsNum <= maxThreadsNumber && !cancellationToken.isCancelled(); ++threadsNum)
+    {
+        threadsNumber = threadsNum;
+        currentX = threadsNum;
+
+        const qreal strongScalingWallTime = measureWallTime(strongScalingGraph.get());
+
+        qreal weakScalingWork = 0.0;
+        qreal weakScalingWallTime = 0.0;
+        if(!cancellationToken.isTruncated())
+        {
+            const QSharedPointer<Graph> weakScalingGraph = buildGraph(weakScalingIterations * threadsNum, weakScalingWork);
+            weakScalingWallTime = measureWallTime(weakScalingGraph.get());
+        }
+
+        if(cancellationToken.isTruncated())
+        {
+            truncationInfo = "truncated : " + QString::number(threadsNum) + " threads, cancelled\n";
+            break;
+        }
+
+        strongScaling.append(threadsNum, strongScalingWallTime, strongScalingWork);
+        weakScaling.append(threadsNum, weakScalingWallTime, weakScalingWork);
+    }
+
+    threadsNumber = 1;
+    graph = nullptr;
+    releaseScratchMemory();
+
+    QString traceInfo;
+    finishTrace(traceInfo);
+
+    QString& toolTipText = baseResultData.toolTipInfo;
+    toolTipText.append("thread scaling : strong at build iterations " + QString::number(iterationsNumber)
+                       + ", weak at " + QString::number(weakScalingIterations) + " build iterations per thread");
+    toolTipText.append("\n");
+
+    for(int i = 0; i < strongScaling.threadsNums.size(); ++i)
+    {
+        toolTipText.append("  " + QString::number(strongScaling.threadsNums[i]) + " threads : " + QString::number(strongScaling.wallTimes[i], 'f', 3)
+                           + " ms, weak " + QString::number(weakScaling.wallTimes[i], 'f', 3) + " ms");
+        toolTipText.append("\n");
+    }
+
+    const QString endTime = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
+    baseResultData.runInfo.endTime = endTime;
+
+    toolTipText.append("start time : " + startTime);
+    toolTipText.append("\n");
+    toolTipText.append("end time : " + endTime);
+    toolTipText.append("\n");
+    toolTipText.append(traceInfo);
+    toolTipText.append(truncationInfo);
+
+    const QList<QPair<QString, QList<QPointF>>> metrics = {
+        {"speedup", strongScaling.getSpeedup()},
+        {"efficiency", strongScaling.getEfficiency()},
+        {"Karp-Flatt", strongScaling.getKarpFlatt()},
+        {"weak scaling efficiency", weakScaling.getEfficiency()},
+    };
+
+    for(const auto& metric : metrics)
+    {
+        AlgorithmBenchmarkResult resultData = baseResultData;
+        resultData.variantName = metric.first;
+        resultData.runInfo.algorithmProperties["scalingMetric"] = metric.first;
+        resultData.mainSeries = metric.second;
+        resultData.toolTipInfo.prepend("metric : " + metric.first + "\n");
+
+        emit finished(resultData);
+    }
+}
+
+qreal GraphAlgorithm::measureWallTime(Graph *testGraph)
+{
+    for(int j = 0; j < warmupRunsNumber && !cancellationToken.isCancelled(); ++j)
+    {
+        prepareExecution(testGraph);
+
+        execute();
+    }
+
+    const int repetitions = std::max(1, repetitionsNumber);
+
+    QList<qreal> samples;
+    samples.reserve(repetitions);
+
+    QElapsedTimer wallTimer;
+
+    for(int j = 0; j < repetitions; ++j)
+    {
+        prepareExecution(testGraph);
+
+        TraceScope executeTrace(executeTraceName, "execute");
+
+        wallTimer.start();
+
+        execute();
+
+        samples.append(wallTimer.nsecsElapsed() / 1e6);
+
+        if(cancellationToken.isCancelled())
+        {
+            break;
+        }
+    }
+
+    return BenchmarkStatistics::fromSamples(samples).median;
+}
+
+void GraphAlgorithm::setUpRunInfo(BenchmarkRunInfo &runInfo, const GraphBuilder *graphBuilder, const QString &startTime) const
+{
+    runInfo.setCurrentEnvironment();
+    runInfo.algorithmName = objectName();
+    runInfo.builderName = graphBuilder->objectName();
+    runInfo.algorithmProperties = BenchmarkRunInfo::propertiesToJsonObject(this);
+    runInfo.algorithmProperties["complexity"] = selectedComplexity;
+    runInfo.algorithmProperties["cacheMode"] = selectedCacheMode;
+    runInfo.builderProperties = BenchmarkRunInfo::propertiesToJsonObject(graphBuilder);
+    runInfo.startTime = startTime;
+}
+
+bool GraphAlgorithm::restoreCheckpointSettings(const BenchmarkCheckpoint &checkpoint, QString &outInfo)
+{
+    if(!Algorithm::restoreCheckpointSettings(checkpoint, outInfo))
+    {
+        return false;
+    }
+
+    GraphBuilder* graphBuilder = qobject_cast<GraphBuilder*>(getSelectedBuilder());
+    graphBuilder->selectImplementation(checkpoint.sweepState["implementation"].toString());
+
+    return true;
+}
+
+BenchmarkCheckpoint GraphAlgorithm::captureCheckpointSettings() const
+{
+    BenchmarkCheckpoint checkpoint = Algorithm::captureCheckpointSettings();
+
+    const GraphBuilder* graphBuilder = qobject_cast<GraphBuilder*>(getSelectedBuilder());
+    checkpoint.sweepState["implementation"] = graphBuilder->getSelectedImplementation();
+
+    return checkpoint;
+}
+
+QList<AlgorithmBenchmarkResult> GraphAlgorithm::createSweepResults(const AlgorithmBenchmarkResult &baseResultData, const QStringList &representations) const
+{
+    QList<AlgorithmBenchmarkResult> results;
+    results.reserve(representations.size());
+
+    for(const QString& representation : representations)
+    {
+        AlgorithmBenchmarkResult& resultData = results.emplace_back(baseResultData);
+        resultData.runInfo.builderProperties["implemention"] = representation;
+        resultData.mainSeries.reserve(iterationsNumber);
+        resultData.mainSeriesStatistics.reserve(iterationsNumber);
+        resultData.mainSeriesInputs.reserve(iterationsNumber);
+
+        if(compareRepresentations)
+        {
+            resultData.variantName = representation;
+            resultData.toolTipInfo.append("representation : " + representation);
+            resultData.toolTipInfo.append("\n");
+        }
+    }
+
+    return results;
+}
+
+QList<AlgorithmBenchmarkResult> GraphAlgorithm::restoreSweepResults(const BenchmarkCheckpoint &checkpoint, const QStringList &representations) const
+{
+    QList<AlgorithmBenchmarkResult> results = checkpoint.results;
+
+    const QString resumeTime = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
+
+    for(int r = 0; r < results.size(); ++r)
+    {
+        AlgorithmBenchmarkResult& resultData = results[r];
+
+        if(compareRepresentations)
+        {
+            resultData.variantName = representations[r];
+        }
+
+        resultData.toolTipInfo.append("resumed : " + resumeTime + " at iteration " + QString::number(checkpoint.nextIteration));
+        resultData.toolTipInfo.append("\n");
+    }
+
+    return results;
+}
+
+QString GraphAlgorithm::saveCheckpoint(const QList<AlgorithmBenchmarkResult> &results, quint64 inputSeed, int nextIteration, const GraphSweepTotals &totals) const
+{
+    BenchmarkCheckpoint checkpoint = captureCheckpointSettings();
+    checkpoint.results = results;
+    checkpoint.inputSeed = inputSeed;
+    checkpoint.nextIteration = nextIteration;
+    checkpoint.sweepState["totals"] = totals.toJsonObject();
+
+    const QString filePath = BenchmarkCheckpoint::getFilePath(objectName());
+
+    QString saveInfo;
+    if(!checkpoint.save(filePath, saveInfo))
+    {
+        return "checkpoint : " + saveInfo + "\n";
+    }
+
+    return "checkpoint : " + filePath + ", resume to continue at iteration " + QString::number(nextIteration) + "\n";
+}
+
+void GraphAlgorithm::takeBackPoint(QList<AlgorithmBenchmarkResult> &results, int truncatedRepresentation) const
+{
+    for(int r = 0; r <= truncatedRepresentation; ++r)
+    {
+        AlgorithmBenchmarkResult& resultData = results[r];
+
+        if(r < truncatedRepresentation)
+        {
+            resultData.mainSeries.removeLast();
+            resultData.mainSeriesStatistics.removeLast();
+            resultData.mainSeriesInputs.removeLast();
+        }
+
+        for(SubSeriesData& subSeriesData : resultData.subSeriesNameToSubSeriesData)
+        {
+            while(!subSeriesData.points.isEmpty() && subSeriesData.points.last().x() == currentX)
+            {
+                subSeriesData.points.removeLast();
+            }
+        }
+    }
+}
+
+ComplexityVariables GraphAlgorithm::buildPointGraphs(GraphBuilder *graphBuilder, int graphsNum, QList<QSharedPointer<Graph>> &outTestGraphs, qreal &outBuildCycles) const
+{
+    ComplexityVariables pointInput;
+    pointInput.iteration = currentIteration;
+    pointInput.minWeight = graphBuilder->getMinWeight();
+    pointInput.maxWeight = graphBuilder->getMaxWeight();
+
+    outTestGraphs.reserve(graphsNum);
+
+    if(buildsOwnInput())
+    {
+        outTestGraphs.append(QSharedPointer<Graph>(graphBuilder->createGraph()));
+        outBuildCycles = 0.0;
+        return pointInput;
+    }
+
+    ULONG64 buildCycles = 0;
+
+    for(int j = 0; j < graphsNum; ++j)
+    {
+        ULONG64 buildStart;
+        ULONG64 buildEnd;
+
+        {
+            TraceScope buildTrace("graph construction", "build");
+
+            QueryThreadCycleTime(GetCurrentThread(), &buildStart);
+
+            outTestGraphs.append(QSharedPointer<Graph>(dynamic_cast<Graph*>(graphBuilder->createDataStructure())));
+
+            QueryThreadCycleTime(GetCurrentThread(), &buildEnd);
+        }
+
+        buildCycles += buildEnd - buildStart;
+
+        const Graph* testGraph = outTestGraphs.last().get();
+        pointInput.nodesNum += testGraph->getNodesNum();
+        pointInput.edgesNum += testGraph->getEdgesNum();
+    }
+
+    pointInput.nodesNum /= graphsNum;
+    pointInput.edgesNum /= graphsNum;
+
+    outBuildCycles = static_cast<qreal>(buildCycles) / graphsNum;
+
+    return pointInput;
+}
+
+QList<QSharedPointer<Graph>> GraphAlgorithm::convertGraphs(const GraphBuilder *graphBuilder, const QList<QSharedPointer<Graph>> &testGraphs, const QString &implementation) const
+{
+    QList<QSharedPointer<Graph>> convertedGraphs;
+    convertedGraphs.reserve(testGraphs.size());
+
+    for(const QSharedPointer<Graph>& testGraph : testGraphs)
+    {
+        convertedGraphs.append(QSharedPointer<Graph>(graphBuilder->convertGraph(testGraph.get(), implementation)));
+    }
+
+    return convertedGraphs;
+}
+
+void GraphAlgorithm::appendRooflinePoints(AlgorithmBenchmarkResult &resultData, const Graph *testGraph, const BenchmarkStatistics &statistics, RooflinePoint &outLastPoint) const
+{
+    RooflinePoint rooflinePoint;
+    if(!estimateTraffic(testGraph, rooflinePoint.bytes, rooflinePoint.operations) || statistics.median <= 0.0)
+    {
+        return;
+    }
+
+    rooflinePoint.cycles = statistics.median;
+    outLastPoint = rooflinePoint;
+
+    SubSeriesData& bandwidthData = resultData["achieved bytes per cycle"];
+    bandwidthData.color = Qt::darkBlue;
+    bandwidthData.points.append(QPointF(currentX, rooflinePoint.getBytesPerCycle()));
+
+    SubSeriesData& throughputData = resultData["achieved operations per cycle"];
+    throughputData.color = Qt::darkRed;
+    throughputData.points.append(QPointF(currentX, rooflinePoint.getOperationsPerCycle()));
+}
+
+void GraphAlgorithm::appendRooflineInfo(AlgorithmBenchmarkResult &resultData, const RooflinePoint &lastPoint) const
+{
+    const RooflineCeilings& ceilings = RooflineProbes::getCeilings();
+    if(lastPoint.cycles <= 0.0 || !ceilings.isValid())
+    {
+        return;
+    }
+
+    const int baseMhz = resultData.runInfo.environment["baseMhz"].toInt();
+
+    QString& toolTipText = resultData.toolTipInfo;
+    toolTipText.append("roofline ceilings : " + ceilings.getDescription(baseMhz));
+    toolTipText.append("\n");
+    toolTipText.append("roofline last point : " + lastPoint.getDescription(ceilings, baseMhz));
+    toolTipText.append("\n");
+}
+
+void GraphAlgorithm::appendValidationInfo(QString &infoText, const QStringList &mismatches, const QStringList &skippedEquivalents, int pointsNum) const
+{
+    infoText.append("validation : " + QString::number(mismatches.size()) + " mismatches in " + QString::number(pointsNum) + " points");
+    infoText.append("\n");
+
+    for(const QString& skippedEquivalent : skippedEquivalents)
+    {
+        infoText.append("  skipped " + skippedEquivalent);
+        infoText.append("\n");
+    }
+
+    for(int m = 0; m < mismatches.size() && m < 5; ++m)
+    {
+        infoText.append("  " + mismatches[m]);
+        infoText.append("\n");
+    }
+}
+
+BenchmarkStatistics GraphAlgorithm::measurePoint(const QList<QSharedPointer<Graph>> &testGraphs, AlgorithmBenchmarkResult &resultData, ThreadAffinityGuard &affinityGuard)
+{
+    BenchmarkTimerRecorder& timerRecorder = BenchmarkTimerRecorder::getThreadRecorder();
+
+    const int repetitions = std::max(1, repetitionsNumber);
+
+    // the warmup has a budget of its own
+    cancellationToken.startBudget(iterationTimeBudget);
+
+    for(int j = 0; j < warmupRunsNumber && !cancellationToken.isTruncated(); ++j)
+    {
+        prepareExecution(testGraphs.first().get());
+
+        execute();
+    }
+
+    if(!cancellationToken.isTruncated())
+    {
+        cancellationToken.startBudget(iterationTimeBudget);
+    }
+
+    QList<qreal> samples;
+    samples.reserve(repetitions);
+
+    timerRecorder.startRecording(currentIteration);
+
+    AllocationStatistics pointAllocations;
+
+    for(int j = 0; j < repetitions && !cancellationToken.isTruncated(); ++j)
+    {
+        Graph* testGraph = testGraphs[j % testGraphs.size()].get();
+        prepareCaches(testGraph, affinityGuard);
+
+        if(cancellationToken.isTruncated())
+        {
+            break;
+        }
+
+        if(trackAllocations)
+        {
+            AllocationTracker::startTracking();
+        }
 
-    dataStructureBuilders.push_back(new GeneralGraphBuilder(this));
-    dataStructureBuilders.push_back(new GridGraphBuilder(this));
-    dataStructureBuilders.push_back(new TreeGraphBuilder(this));
-}
+        ULONG64 start;
+        ULONG64 end;
 
-GraphAlgorithm::~GraphAlgorithm()
-{
+        {
+            TraceScope executeTrace(executeTraceName, "execute");
 
-}
+            QueryThreadCycleTime(GetCurrentThread(), &start);
 
-QWidget *GraphAlgorithm::createPropertiesWidget(QWidget *parent)
-{
-    builderPropertiesWidget = nullptr;
+            execute();
 
-    QWidget* propertiesWidget = Algorithm::createPropertiesWidget(parent);
+            QueryThreadCycleTime(GetCurrentThread(), &end);
+        }
 
-    QVBoxLayout* verticalLayout = qobject_cast<QVBoxLayout*>(propertiesWidget->layout());
-    QFormLayout* formLayout = propertiesWidget->findChild<QFormLayout*>();
+        if(trackAllocations)
+        {
+            const AllocationStatistics allocations = AllocationTracker::stopTracking();
+            pointAllocations.allocationsNum += allocations.allocationsNum;
+            pointAllocations.allocatedBytes += allocations.allocatedBytes;
+            pointAllocations.peakLiveBytes = std::max(pointAllocations.peakLiveBytes, allocations.peakLiveBytes);
+        }
+
+        // the sample of a truncated run is kept, run reports it as the cycles spent before the kernel gave up
+        samples.append((end - start) - timerRecorder.takeTimersWorkCycles());
+    }
+
+    cancellationToken.stopBudget();
 
-    builderComboBox = new QComboBox(propertiesWidget);
+    timerRecorder.stopRecording();
 
-    for(const auto* builder : dataStructureBuilders)
+    const Graph* builtGraph = buildsOwnInput() ? getBuiltGraph() : nullptr;
+    if(builtGraph)
     {
-        builderComboBox->addItem(builder->objectName(), QVariant::fromValue(builder));
+        currentInput.nodesNum = builtGraph->getNodesNum();
+        currentInput.edgesNum = builtGraph->getEdgesNum();
+        currentX = currentComplexity.evaluate(currentInput);
     }
 
-    formLayout->addRow("builder", builderComboBox);
+    timerRecorder.flush(resultData, currentX, repetitions);
 
-    auto onBuilderSelected = [this, verticalLayout, parent](const QString& currentText)
+    if(trackAllocations)
     {
-        if(builderPropertiesWidget)
+        appendAllocationPoints(resultData, pointAllocations, repetitions);
+    }
+
+    return BenchmarkStatistics::fromSamples(samples);
+}
+
+void GraphAlgorithm::prepareCaches(Graph *testGraph, ThreadAffinityGuard &affinityGuard)
+{
+    if(currentCacheMode == CacheModes::Warm || currentCacheMode == CacheModes::OtherCore)
+    {
+        BenchmarkTimerRecorder& timerRecorder = BenchmarkTimerRecorder::getThreadRecorder();
+        timerRecorder.stopRecording();
+
+        if(currentCacheMode == CacheModes::OtherCore)
         {
-            verticalLayout->removeWidget(builderPropertiesWidget);
-            builderPropertiesWidget->deleteLater();
-            builderPropertiesWidget = nullptr;
+            affinityGuard.moveTo(builderCore);
         }
 
-        PropertyEditorFactory& propertyEditorFactory = PropertyEditorFactory::get();
+        cancellationToken.pauseBudget();
 
-        builderPropertiesWidget = getSelectedBuilder()->createPropertiesWidget(parent);
+        prepareExecution(testGraph);
 
-        verticalLayout->addWidget(builderPropertiesWidget);
-    };
+        execute();
 
-    connect(builderComboBox, &QComboBox::currentTextChanged, this, onBuilderSelected);
+        cancellationToken.resumeBudget();
 
-    onBuilderSelected(builderComboBox->currentText());
+        if(currentCacheMode == CacheModes::OtherCore)
+        {
+            affinityGuard.moveTo(executionCore);
+        }
 
-    return propertiesWidget;
+        timerRecorder.startRecording(currentIteration);
+    }
+
+    prepareExecution(testGraph);
+
+    if(currentCacheMode == CacheModes::Cold)
+    {
+        CacheControl::evictCaches();
+    }
 }
 
-void GraphAlgorithm::appendPropertiesInfo(QString &infoText)
+void GraphAlgorithm::appendAllocationPoints(AlgorithmBenchmarkResult &resultData, const AllocationStatistics &allocations, int runsNum) const
 {
-    Algorithm::appendPropertiesInfo(infoText);
+    SubSeriesData& allocationsNumData = resultData["allocations number"];
+    allocationsNumData.color = Qt::darkCyan;
+    allocationsNumData.points.append(QPointF(currentX, static_cast<qreal>(allocations.allocationsNum) / runsNum));
 
-    infoText.append("builder : " + builderComboBox->currentText());
-    infoText.append("\n");
+    SubSeriesData& allocatedBytesData = resultData["allocated bytes"];
+    allocatedBytesData.color = Qt::darkMagenta;
+    allocatedBytesData.points.append(QPointF(currentX, static_cast<qreal>(allocations.allocatedBytes) / runsNum));
+
+    SubSeriesData& peakLiveBytesData = resultData["peak live bytes"];
+    peakLiveBytesData.color = Qt::darkYellow;
+    peakLiveBytesData.aggregationMode = AggregationMode::Max;
+    peakLiveBytesData.points.append(QPointF(currentX, static_cast<qreal>(allocations.peakLiveBytes)));
 }
 
-void GraphAlgorithm::run()
+size_t GraphAlgorithm::getResultChecksum() const
 {
-    requestedEnd = false;
-
-    AlgorithmBenchmarkTimerManager &timerManager = AlgorithmBenchmarkTimerManager::getTimerManager();
-    timerManager.clear(this);
+    return qHashMulti(qHashRange(resultNodes.begin(), resultNodes.end()), resultValue);
+}
 
-    AlgorithmBenchmarkResult& resultData = timerManager.algorithmToResultData[this];
-    resultData.mainSeries.reserve(iterationsNumber);
+qint64 GraphAlgorithm::getValidationValue() const
+{
+    return resultValue;
+}
 
-    QString& toolTipText = resultData.toolTipInfo;
-    appendPropertiesInfo(toolTipText);
+QList<GraphAlgorithm*> GraphAlgorithm::createEquivalentAlgorithms(QStringList& outSkipped) const
+{
+    QList<GraphAlgorithm*> equivalentAlgorithms = createValidationGroup(getValidationGroup());
 
-    GraphBuilder* graphBuilder = qobject_cast<GraphBuilder*>(getSelectedBuilder());
-    graphBuilder->appendPropertiesInfo(toolTipText);
+    const DataStructureBuilder* builder = getSelectedBuilder();
+    const QMetaObject* builderMetaObject = builder->metaObject();
 
-    currentComplexityFunction = std::find_if(complexityList.begin(), complexityList.end(), [&](const ComplexityNameToFunction& pair)
+    for(auto it = equivalentAlgorithms.begin(); it != equivalentAlgorithms.end(); )
     {
-        return pair.first == selectedComplexity;
-    })->second;
+        GraphAlgorithm* equivalentAlgorithm = *it;
 
-    const QString startTime = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
-    emit started();
+        bool canRun = equivalentAlgorithm->metaObject() != metaObject();
+        QString info;
 
-    int i = 0;
-    for(; i < iterationsNumber; ++i)
-    {
-        if(requestedEnd)
+        if(canRun && !equivalentAlgorithm->selectBuilder(builder->objectName()))
         {
-            break;
+            canRun = false;
+            info = AlgorithmTexts::UnknownJobBuilder + builder->objectName();
         }
 
-        graphBuilder->buildIterations = i + 1;
-        currentIteration = i;
-
-        QScopedPointer<Graph> testGraph(dynamic_cast<Graph*>(graphBuilder->createDataStructure()));
-        graph = testGraph.get();
+        if(canRun)
+        {
+            DataStructureBuilder* equivalentBuilder = equivalentAlgorithm->getSelectedBuilder();
+            for(int i = 0; i < builderMetaObject->propertyCount(); ++i)
+            {
+                const char* propertyName = builderMetaObject->property(i).name();
+                equivalentBuilder->setProperty(propertyName, builder->property(propertyName));
+            }
 
-        ULONG64 start;
-        QueryThreadCycleTime(GetCurrentThread(), &start);
+            canRun = equivalentAlgorithm->canRunAlgorithm(info);
+        }
 
-        execute();
+        if(canRun)
+        {
+            ++it;
+            continue;
+        }
 
-        ULONG64 end;
-        QueryThreadCycleTime(GetCurrentThread(), &end);
+        if(equivalentAlgorithm->metaObject() != metaObject())
+        {
+            outSkipped.append(equivalentAlgorithm->objectName() + " : " + info);
+        }
 
-        const QPointF point(calculateXForCurrentIteration(), (end - start) - timerManager.takeTimersWorkCycles());
-        resultData.mainSeries.append(point);
+        delete equivalentAlgorithm;
+        it = equivalentAlgorithms.erase(it);
     }
 
-    graph = nullptr;
-    currentIteration = 0;
+    return equivalentAlgorithms;
+}
 
-    toolTipText.append("build iterations : " + QString::number(i));
-    toolTipText.append("\n");
+bool GraphAlgorithm::estimateTraffic(const Graph *testGraph, qreal &outBytes, qreal &outOperations) const
+{
+    return false;
+}
 
-    toolTipText.append("start time : " + startTime);
-    toolTipText.append("\n");
+void GraphAlgorithm::validatePoint(Graph *testGraph, const QList<GraphAlgorithm*> &equivalentAlgorithms, QStringList &outMismatches)
+{
+    TraceScope validationTrace("validation", "validate");
 
-    toolTipText.append("end time : " + QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss"));
-    toolTipText.append("\n");
+    prepareExecution(testGraph);
+    execute();
+
+    // a cancelled kernel left an incomplete result, comparing it would report a false mismatch
+    if(cancellationToken.isTruncated())
+    {
+        return;
+    }
+
+    const qint64 expectedValue = getValidationValue();
+
+    for(GraphAlgorithm* equivalentAlgorithm : equivalentAlgorithms)
+    {
+        equivalentAlgorithm->prepareExecution(testGraph);
+        equivalentAlgorithm->execute();
 
-    emit finished(resultData);
+        const qint64 value = equivalentAlgorithm->getValidationValue();
+        if(value != expectedValue)
+        {
+            outMismatches.append("x = " + QString::number(currentX, 'g', 6) + " : " + equivalentAlgorithm->objectName()
+                                 + " " + QString::number(value) + ", expected " + QString::number(expectedValue));
+        }
+
+        equivalentAlgorithm->graph = nullptr;
+    }
 }
 
 qreal GraphAlgorithm::calculateXForCurrentIteration() const
 {
-    return currentComplexityFunction(currentIteration, graph->getNodesNum(), graph->getEdgesNum());
+    return currentX;
 }
 
 #ifdef QT_DEBUG
@@ -206,15 +1235,119 @@ void GraphAlgorithm::debugRun()
     testGraph->addEdge(0, 1, 1);
     testGraph->addEdge(0, 1, 1);
 
+    prepareExecution(testGraph.get());
     execute();
+
+    releaseScratchMemory();
 }
 #endif
 
-DataStructureBuilder *GraphAlgorithm::getSelectedBuilder() const
+bool GraphAlgorithm::canRunBenchmark(QString &outInfo) const
+{
+    if(!Algorithm::canRunBenchmark(outInfo))
+    {
+        return false;
+    }
+
+    const GraphBuilder* graphBuilder = qobject_cast<GraphBuilder*>(getSelectedBuilder());
+    if(compareRepresentations && graphBuilder->getImplementations().size() < 2)
+    {
+        outInfo = GraphTexts::SingleRepresentationBuilder;
+        return false;
+    }
+
+    if(validateResults && getValidationGroup().isEmpty())
+    {
+        outInfo = GraphTexts::NoEquivalentAlgorithms;
+        return false;
+    }
+
+    return true;
+}
+
+QString GraphAlgorithm::getValidationGroup() const
+{
+    return QString();
+}
+
+bool GraphAlgorithm::getValidateResults() const
 {
-    return builderComboBox->currentData(Qt::UserRole).value<DataStructureBuilder*>();
+    return validateResults;
 }
 
+void GraphAlgorithm::setValidateResults(bool newValidateResults)
+{
+    if (validateResults == newValidateResults)
+    {
+        return;
+    }
+
+    validateResults = newValidateResults;
+    emit validateResultsChanged();
+}
+
+bool GraphAlgorithm::getCompareRepresentations() const
+{
+    return compareRepresentations;
+}
+
+void GraphAlgorithm::setCompareRepresentations(bool newCompareRepresentations)
+{
+    if (compareRepresentations == newCompareRepresentations)
+    {
+        return;
+    }
+
+    compareRepresentations = newCompareRepresentations;
+    emit compareRepresentationsChanged();
+}
+
+bool GraphAlgorithm::getRegenerateGraphPerRepetition() const
+{
+    return regenerateGraphPerRepetition;
+}
+
+void GraphAlgorithm::setRegenerateGraphPerRepetition(bool newRegenerateGraphPerRepetition)
+{
+    if (regenerateGraphPerRepetition == newRegenerateGraphPerRepetition)
+    {
+        return;
+    }
+
+    regenerateGraphPerRepetition = newRegenerateGraphPerRepetition;
+    emit regenerateGraphPerRepetitionChanged();
+}
+
+void GraphAlgorithm::prepareGraphForExecution(Graph *testGraph)
+{
+
+}
+
+void GraphAlgorithm::prepareExecution(Graph *testGraph)
+{
+    prepareGraphForExecution(testGraph);
+    graph = testGraph;
+
+    workspace.reset();
+    workspace.reserve(testGraph->getNodesNum());
+}
+
+void GraphAlgorithm::releaseScratchMemory()
+{
+    workspace.release();
+}
+
+bool GraphAlgorithm::buildsOwnInput() const
+{
+    return false;
+}
+
+const Graph *GraphAlgorithm::getBuiltGraph() const
+{
+    return nullptr;
+}
+
+
 BFSIterative::BFSIterative(QObject *parent)
     : GraphAlgorithm(parent)
 {
@@ -223,21 +1356,24 @@ BFSIterative::BFSIterative(QObject *parent)
 
 void BFSIterative::execute()
 {
-    QQueue<int> nodeQueue;
-    nodeQueue.reserve(graph->getNodesNum());
+    QList<int>& nodeQueue = workspace.takeInts();
+    qsizetype queueHead = 0;
 
-    QList<bool> visited;
-    visited.fill(false, graph->getNodesNum());
+    VisitedMarks& visited = workspace.takeVisitedMarks(graph->getNodesNum());
 
-    nodeQueue.enqueue(0);
-    visited[0] = true;
+    nodeQueue.append(0);
+    visited.visit(0);
+
+    int visitedNodesNum = 1;
 
     auto forEachNeighbour = [&](int start, int neighbour, int weight)
     {
-        if(!visited[neighbour])
+        BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
+        if(visited.tryVisit(neighbour))
         {
-            visited[neighbour] = true;
-            nodeQueue.enqueue(neighbour);
+            visitedNodesNum++;
+            nodeQueue.append(neighbour);
         }
         return true;
     };
@@ -245,12 +1381,22 @@ void BFSIterative::execute()
     {
         BENCHMARK_SCOPED_TIMER("while loop + get edges num", Qt::green, AggregationMode::Sum)
 
-        while(!nodeQueue.empty())
+        while(queueHead < nodeQueue.size())
         {
-            const int first = nodeQueue.dequeue();
+            const int first = nodeQueue[queueHead++];
+            BENCHMARK_COUNTER("nodes dequeued", Qt::darkMagenta)
+
             graph->forEachNeighbour(first, forEachNeighbour);
         }
     }
+
+    resultValue = visitedNodesNum;
+}
+
+bool BFSIterative::estimateTraffic(const Graph *testGraph, qreal &outBytes, qreal &outOperations) const
+{
+    estimateBreadthFirstTraffic(testGraph, resultValue, outBytes, outOperations);
+    return true;
 }
 
 BFSRecursive::BFSRecursive(QObject *parent)
@@ -264,23 +1410,34 @@ void BFSRecursive::execute()
     QQueue<int> nodeQueue;
     nodeQueue.reserve(graph->getNodesNum());
 
-    QList<bool> visited;
-    visited.fill(false, graph->getNodesNum());
+    VisitedMarks& visited = workspace.takeVisitedMarks(graph->getNodesNum());
 
     nodeQueue.enqueue(0);
-    visited[0] = true;
+    visited.visit(0);
+
+    int visitedNodesNum = 1;
 
     auto func = [&](int start, int neighbour, int weight)
     {
-        if(!visited[neighbour])
+        BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
+        if(visited.tryVisit(neighbour))
         {
-            visited[neighbour] = true;
+            visitedNodesNum++;
             nodeQueue.enqueue(neighbour);
         }
         return true;
     };
 
     BFSRecursiveHelper(nodeQueue, func);
+
+    resultValue = visitedNodesNum;
+}
+
+bool BFSRecursive::estimateTraffic(const Graph *testGraph, qreal &outBytes, qreal &outOperations) const
+{
+    estimateBreadthFirstTraffic(testGraph, resultValue, outBytes, outOperations);
+    return true;
 }
 
 void BFSRecursive::BFSRecursiveHelper(QQueue<int>& nodeQueue, std::function<bool (int, int, int)> forEachNeighbourFunc)
@@ -291,6 +1448,8 @@ void BFSRecursive::BFSRecursiveHelper(QQueue<int>& nodeQueue, std::function<bool
     }
 
     const int first = nodeQueue.dequeue();
+    BENCHMARK_COUNTER("nodes dequeued", Qt::darkMagenta)
+
     graph->forEachNeighbour(first, forEachNeighbourFunc);
     BFSRecursiveHelper(nodeQueue, forEachNeighbourFunc);
 }
@@ -303,29 +1462,35 @@ DFSIterative::DFSIterative(QObject *parent)
 
 void DFSIterative::execute()
 {
-    QList<bool> visited;
-    visited.fill(false, graph->getNodesNum());
-    visited[0] = true;
+    VisitedMarks& visited = workspace.takeVisitedMarks(graph->getNodesNum());
+    visited.visit(0);
 
-    QStack<int> nodesStack;
-    nodesStack.reserve(graph->getNodesNum());
-    nodesStack.push(0);
+    QList<int>& nodesStack = workspace.takeInts();
+    nodesStack.append(0);
+
+    int visitedNodesNum = 1;
 
     auto forEachNeighbour = [&](int start, int neighbour, int weight)
     {
-        if(!visited[neighbour])
+        BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
+        if(visited.tryVisit(neighbour))
         {
-            visited[neighbour] = true;
-            nodesStack.push(neighbour);
+            visitedNodesNum++;
+            nodesStack.append(neighbour);
         }
         return true;
     };
 
     while(!nodesStack.isEmpty())
     {
-        const int first = nodesStack.pop();
+        const int first = nodesStack.takeLast();
+        BENCHMARK_COUNTER("nodes popped", Qt::darkMagenta)
+
         graph->forEachNeighbour(first, forEachNeighbour);
     }
+
+    resultValue = visitedNodesNum;
 }
 
 DFSRecursive::DFSRecursive(QObject *parent)
@@ -336,19 +1501,24 @@ DFSRecursive::DFSRecursive(QObject *parent)
 
 void DFSRecursive::execute()
 {
-    QList<bool> visited;
-    visited.fill(false, graph->getNodesNum());
+    VisitedMarks& visited = workspace.takeVisitedMarks(graph->getNodesNum());
 
+    resultValue = 0;
     DFSHelper(0, visited);
 }
 
-void DFSRecursive::DFSHelper(int begin, QList<bool>& visited)
+void DFSRecursive::DFSHelper(int begin, VisitedMarks& visited)
 {
-    visited[begin] = true;
+    BENCHMARK_COUNTER("DFS calls", Qt::darkMagenta)
+
+    visited.visit(begin);
+    resultValue++;
 
     auto func = [&](int start, int neighbour, int weight)
     {
-        if(!visited[neighbour])
+        BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
+        if(!visited.isVisited(neighbour))
         {
             DFSHelper(neighbour, visited);
         }
@@ -392,6 +1562,8 @@ void TreeCenters::execute()
 
         auto forEachNeighbour = [&](int value, int neighbour, int weight)
         {
+            BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
             if(--inDegrees[neighbour] == 1)
             {
                 newLeafNodes.push_back(neighbour);
@@ -409,7 +1581,7 @@ void TreeCenters::execute()
         leafNodes = newLeafNodes;
     }
 
-    const QList<int> centers = leafNodes;
+    resultNodes = std::move(leafNodes);
 }
 
 TopologicalSort::TopologicalSort(QObject *parent)
@@ -437,27 +1609,46 @@ void TopologicalSort::execute()
 {
     const qsizetype nodesNum = graph->getNodesNum();
 
-    QList<bool> visited(nodesNum, false);
+    VisitedMarks& visited = workspace.takeVisitedMarks(nodesNum);
 
     QStack<int> topologicalOrder;
     topologicalOrder.reserve(graph->getNodesNum());
 
     for(int i = 0; i < nodesNum; ++i)
     {
-        if(!visited[i])
+        if(!visited.isVisited(i))
         {
             TopologicalSortHelper(i, visited, topologicalOrder);
         }
     };
+
+    resultNodes = std::move(topologicalOrder);
 }
 
-void TopologicalSort::TopologicalSortHelper(int begin, QList<bool> &visited, QStack<int>& topologicalOrder)
+qint64 TopologicalSort::getValidationValue() const
 {
-    visited[begin] = true;
+    QList<int> topologicalOrder = resultNodes;
+    std::reverse(topologicalOrder.begin(), topologicalOrder.end());
+
+    return getTopologicalOrderValue(graph, topologicalOrder);
+}
+
+QString TopologicalSort::getValidationGroup() const
+{
+    return ValidationGroups::TopologicalOrder;
+}
+
+void TopologicalSort::TopologicalSortHelper(int begin, VisitedMarks &visited, QStack<int>& topologicalOrder)
+{
+    BENCHMARK_COUNTER("DFS calls", Qt::darkMagenta)
+
+    visited.visit(begin);
 
     auto forEachNeighbour = [&](int start, int neighbour, int weight)
     {
-        if(!visited[neighbour])
+        BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
+        if(!visited.isVisited(neighbour))
         {
             TopologicalSortHelper(neighbour, visited, topologicalOrder);
         }
@@ -508,6 +1699,8 @@ void KahnsAlgorithm::execute()
 
     auto forEachNeighbour = [&](int value, int neighbour, int weight)
     {
+        BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
         if(--inDegrees[neighbour] == 0)
         {
             nodeQueue.enqueue(neighbour);
@@ -518,6 +1711,8 @@ void KahnsAlgorithm::execute()
     while(!nodeQueue.empty())
     {
         const int first = nodeQueue.dequeue();
+        BENCHMARK_COUNTER("nodes dequeued", Qt::darkMagenta)
+
         topologicalOrder.push_back(first);
         graph->forEachNeighbour(first, forEachNeighbour);
     }
@@ -527,6 +1722,17 @@ void KahnsAlgorithm::execute()
         topologicalOrder.clear(); // cycle
     }
 
+    resultNodes = std::move(topologicalOrder);
+}
+
+qint64 KahnsAlgorithm::getValidationValue() const
+{
+    return getTopologicalOrderValue(graph, resultNodes);
+}
+
+QString KahnsAlgorithm::getValidationGroup() const
+{
+    return ValidationGroups::TopologicalOrder;
 }
 
 LazyDijkstraAlgorithm::LazyDijkstraAlgorithm(QObject *parent)
@@ -538,53 +1744,68 @@ LazyDijkstraAlgorithm::LazyDijkstraAlgorithm(QObject *parent)
 bool LazyDijkstraAlgorithm::canRunAlgorithm(QString &outInfo) const
 {
     const GraphBuilder* graphBuilder = qobject_cast<GraphBuilder*>(getSelectedBuilder());
-    if(graphBuilder->getIsGraphDirected())
+    if(!graphBuilder->getIsGraphDirected())
     {
-        return true;
+        outInfo = GraphTexts::UndirectedGraphIsNotSupported;
+        return false;
     }
 
-    outInfo = GraphTexts::UndirectedGraphIsNotSupported;
-    return false;
+    if(graphBuilder->getMinWeight() < 0)
+    {
+        outInfo = GraphTexts::NegativeWeightsAreNotSupported;
+        return false;
+    }
+
+    return true;
+}
+
+QString LazyDijkstraAlgorithm::getValidationGroup() const
+{
+    return ValidationGroups::ShortestPath;
 }
 
 void LazyDijkstraAlgorithm::execute()
 {
     const qsizetype nodesNum = graph->getNodesNum();
 
-    QList<int> distances(nodesNum, INT_MAX);
+    QList<int>& distances = workspace.takeInts(nodesNum, INT_MAX);
     distances[0] = 0;
 
-    QList<int> prev(nodesNum, -1);
+    QList<int>& prev = workspace.takeInts(nodesNum, -1);
 
     PriorityQueue nodeDistancePairs;
     nodeDistancePairs.insert(0, 0);
 
     auto forEachNeighbour = [&](int value, int neighbour, int weight)
     {
+        BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
         const int newDist = distances[value] + weight;
         if(distances[neighbour] > newDist)
         {
             distances[neighbour] = newDist;
             prev[neighbour] = value;
 
+            BENCHMARK_COUNTER("relaxations", Qt::darkGreen)
+            BENCHMARK_COUNTER("heap inserts", Qt::darkYellow)
+
             nodeDistancePairs.insert(neighbour, newDist);
         }
 
         return true;
     };
 
-    QList<bool> visited(nodesNum, false);
+    VisitedMarks& visited = workspace.takeVisitedMarks(nodesNum);
 
     while(!nodeDistancePairs.empty())
     {
         const IntPair top = nodeDistancePairs.extract();
+        BENCHMARK_COUNTER("heap extracts", Qt::darkRed)
 
-        if(visited[top.first])
+        if(!visited.tryVisit(top.first))
         {
             continue;
-        };
-
-        visited[top.first] = true;
+        }
 
         if(top.first == nodesNum - 1)
         {
@@ -609,64 +1830,95 @@ void LazyDijkstraAlgorithm::execute()
     {
         resultPath.clear();
     }
+
+    resultNodes = std::move(resultPath);
+    resultValue = distances[nodesNum - 1];
 }
 
 EagerDijkstraAlgorithm::EagerDijkstraAlgorithm(QObject *parent)
     : GraphAlgorithm(parent)
 {
-    setObjectName("Eager Dijkstra's");
+    setObjectName("Eager Dijkstra's");
+}
+
+bool EagerDijkstraAlgorithm::canRunAlgorithm(QString &outInfo) const
+{
+    const GraphBuilder* graphBuilder = qobject_cast<GraphBuilder*>(getSelectedBuilder());
+    if(!graphBuilder->getIsGraphDirected())
+    {
+        outInfo = GraphTexts::UndirectedGraphIsNotSupported;
+        return false;
+    }
+
+    if(graphBuilder->getMinWeight() < 0)
+    {
+        outInfo = GraphTexts::NegativeWeightsAreNotSupported;
+        return false;
+    }
+
+    return true;
+}
+
+QString EagerDijkstraAlgorithm::getValidationGroup() const
+{
+    return ValidationGroups::ShortestPath;
+}
+
+void EagerDijkstraAlgorithm::prepareGraphForExecution(Graph *testGraph)
+{
+    GraphAlgorithm::prepareGraphForExecution(testGraph);
+
+    nodeDistancePairs.reset(testGraph->getNodesNum());
 }
 
-bool EagerDijkstraAlgorithm::canRunAlgorithm(QString &outInfo) const
+void EagerDijkstraAlgorithm::releaseScratchMemory()
 {
-    const GraphBuilder* graphBuilder = qobject_cast<GraphBuilder*>(getSelectedBuilder());
-    if(graphBuilder->getIsGraphDirected())
-    {
-        return true;
-    }
+    GraphAlgorithm::releaseScratchMemory();
 
-    outInfo = GraphTexts::UndirectedGraphIsNotSupported;
-    return false;
+    nodeDistancePairs.release();
 }
 
 void EagerDijkstraAlgorithm::execute()
 {
     const qsizetype nodesNum = graph->getNodesNum();
 
-    QList<int> distances(nodesNum, INT_MAX);
+    QList<int>& distances = workspace.takeInts(nodesNum, INT_MAX);
     distances[0] = 0;
 
-    QList<int> prev(nodesNum, -1);
+    QList<int>& prev = workspace.takeInts(nodesNum, -1);
 
-    IndexedPriorityQueue nodeDistancePairs;
     nodeDistancePairs.insert(0, 0);
 
     auto forEachNeighbour = [&](int value, int neighbour, int weight)
     {
+        BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
         const int newDist = distances[value] + weight;
         if(distances[neighbour] > newDist)
         {
             distances[neighbour] = newDist;
             prev[neighbour] = value;
 
+            BENCHMARK_COUNTER("relaxations", Qt::darkGreen)
+            BENCHMARK_COUNTER("heap insert / decrease keys", Qt::darkYellow)
+
             nodeDistancePairs.updateKey(neighbour, newDist);
         }
 
         return true;
     };
 
-    QList<bool> visited(nodesNum, false);
+    VisitedMarks& visited = workspace.takeVisitedMarks(nodesNum);
 
     while(!nodeDistancePairs.empty())
     {
         const int first = nodeDistancePairs.extract().first;
+        BENCHMARK_COUNTER("heap extracts", Qt::darkRed)
 
-        if(visited[first])
+        if(!visited.tryVisit(first))
         {
             continue;
-        };
-
-        visited[first] = true;
+        }
 
         if(first == nodesNum - 1)
         {
@@ -691,11 +1943,15 @@ void EagerDijkstraAlgorithm::execute()
     {
         resultPath.clear();
     }
+
+    resultNodes = std::move(resultPath);
+    resultValue = distances[nodesNum - 1];
 }
 
 BellmanFordAlgorithm::BellmanFordAlgorithm(QObject *parent)
     : GraphAlgorithm(parent)
     , breakIfNoChange(true)
+    , sweepsNum(0)
 {
     setObjectName("Bellman–Ford");
 }
@@ -703,24 +1959,32 @@ BellmanFordAlgorithm::BellmanFordAlgorithm(QObject *parent)
 void BellmanFordAlgorithm::execute()
 {
     const qsizetype nodesNum = graph->getNodesNum();
-    QList<int> distances(nodesNum, INT_MAX);
+    QList<int>& distances = workspace.takeInts(nodesNum, INT_MAX);
     distances[0] = 0;
 
     bool anyChange = false;
     auto forEachEdge = [&](int start, int end, int weight)
     {
-        if(distances[start] + weight < distances[end])
+        BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
+        // an unreached start would overflow
+        if(distances[start] != INT_MAX && distances[start] + weight < distances[end])
         {
+            BENCHMARK_COUNTER("relaxations", Qt::darkGreen)
+
             distances[end] = distances[start] + weight;
             anyChange = true;
         }
         return true;
     };
 
+    sweepsNum = 0;
+
     for(int i = 0; i < nodesNum - 1; ++i)
     {
         anyChange = false;
         graph->forEachEdge(forEachEdge);
+        sweepsNum++;
 
         if(breakIfNoChange && !anyChange)
         {
@@ -732,7 +1996,7 @@ void BellmanFordAlgorithm::execute()
     {
         auto dedectNegativeCycle = [&](int start, int end, int weight)
         {
-            if(distances[start] + weight < distances[end])
+            if(distances[start] != INT_MAX && distances[start] != INT_MIN && distances[start] + weight < distances[end])
             {
                 distances[end] = INT_MIN;
                 anyChange = true;
@@ -741,7 +2005,28 @@ void BellmanFordAlgorithm::execute()
         };
 
         graph->forEachEdge(dedectNegativeCycle);
+        sweepsNum++;
     }
+
+    resultValue = distances[nodesNum - 1];
+
+    resultNodes.resize(nodesNum);
+    std::copy(distances.cbegin(), distances.cend(), resultNodes.begin());
+}
+
+bool BellmanFordAlgorithm::estimateTraffic(const Graph *testGraph, qreal &outBytes, qreal &outOperations) const
+{
+    const qreal storedEdgesNum = getStoredEdgesNum(testGraph);
+
+    outBytes = sweepsNum * (testGraph->getNodesNum() * testGraph->getNodeScanBytes()
+                            + storedEdgesNum * (testGraph->getEdgeScanBytes() + 2 * sizeof(int)));
+    outOperations = sweepsNum * storedEdgesNum * 2.0;
+    return true;
+}
+
+QString BellmanFordAlgorithm::getValidationGroup() const
+{
+    return ValidationGroups::ShortestPath;
 }
 
 bool BellmanFordAlgorithm::getBreakIfNoChange() const
@@ -788,6 +2073,13 @@ void FloydWarshallAlgorithm::execute()
 
     for(int k = 0; k < nodesNum; k++)
     {
+        if(cancellationToken.shouldStop())
+        {
+            resultNodes.clear();
+            resultValue = INF;
+            return;
+        }
+
         for(int i = 0; i < nodesNum; i++)
         {
             for(int j = 0; j < nodesNum; j++)
@@ -800,6 +2092,8 @@ void FloydWarshallAlgorithm::execute()
                 const int newDist = dist[i][k] + dist[k][j];
                 if(dist[i][j] > newDist)
                 {
+                    BENCHMARK_COUNTER("relaxations", Qt::darkGreen)
+
                     dist[i][j] = newDist;
                     next[i][j] = next[i][k];
                 }
@@ -809,6 +2103,13 @@ void FloydWarshallAlgorithm::execute()
 
     for(int k = 0; k < nodesNum; k++)
     {
+        if(cancellationToken.shouldStop())
+        {
+            resultNodes.clear();
+            resultValue = INF;
+            return;
+        }
+
         for(int i = 0; i < nodesNum; i++)
         {
             for(int j = 0; j < nodesNum; j++)
@@ -848,6 +2149,204 @@ void FloydWarshallAlgorithm::execute()
     {
         resultPath.clear();
     }
+
+    resultNodes = std::move(resultPath);
+    resultValue = dist[start][end];
+}
+
+bool FloydWarshallAlgorithm::estimateTraffic(const Graph *testGraph, qreal &outBytes, qreal &outOperations) const
+{
+    const qreal nodesNum = testGraph->getNodesNum();
+
+    outBytes = 2.0 * nodesNum * nodesNum * nodesNum * sizeof(int);
+    outOperations = 2.0 * nodesNum * nodesNum * nodesNum * 2.0;
+    return true;
+}
+
+ParallelFloydWarshallAlgorithm::ParallelFloydWarshallAlgorithm(QObject *parent)
+    : GraphAlgorithm(parent)
+{
+    setObjectName("Floyd-Warshall (Parallel)");
+}
+
+bool ParallelFloydWarshallAlgorithm::isParallel() const
+{
+    return true;
+}
+
+void ParallelFloydWarshallAlgorithm::execute()
+{
+    const qsizetype nodesNum = graph->getNodesNum();
+    const int infinity = INF;
+
+    if(nodesNum == 0)
+    {
+        resultNodes.clear();
+        resultValue = infinity;
+        return;
+    }
+
+    // flat matrices, so the threads never touch the implicit sharing of nested lists
+    QList<int> distMatrix(nodesNum * nodesNum, infinity);
+    QList<int> nextMatrix(nodesNum * nodesNum, -1);
+
+    int* dist = distMatrix.data();
+    int* next = nextMatrix.data();
+
+    auto forEachNeighbour = [&](int value, int neighbour, int weight)
+    {
+        dist[value * nodesNum + neighbour] = weight;
+        next[value * nodesNum + neighbour] = neighbour;
+        return true;
+    };
+
+    for(int i = 0; i < nodesNum; i++)
+    {
+        dist[i * nodesNum + i] = 0;
+        graph->forEachNeighbour(i, forEachNeighbour);
+    }
+
+    const int threadsNum = static_cast<int>(std::clamp<qsizetype>(threadsNumber, 1, std::max<qsizetype>(nodesNum, 1)));
+    const qsizetype rowsPerThread = (nodesNum + threadsNum - 1) / threadsNum;
+
+    std::barrier syncPoint(threadsNum);
+
+    // only the calling thread polls the token, it publishes the answer before the barrier every thread passes ahead of reading it,
+    // so all threads leave in the same round and none waits at the barrier for the others
+    std::atomic<bool> stopped{false};
+
+    auto shouldStopRound = [&](bool isCallingThread)
+    {
+        if(isCallingThread && cancellationToken.shouldStop())
+        {
+            stopped.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    // row k is copied before anyone writes in the round of k, so its owner never races with the threads reading it
+    auto relaxRows = [&](qsizetype firstRow, qsizetype endRow, bool isCallingThread)
+    {
+        QList<int> rowK(nodesNum);
+
+        for(int k = 0; k < nodesNum; k++)
+        {
+            shouldStopRound(isCallingThread);
+            std::copy(dist + k * nodesNum, dist + (k + 1) * nodesNum, rowK.begin());
+            syncPoint.arrive_and_wait();
+
+            if(stopped.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            for(qsizetype i = firstRow; i < endRow; i++)
+            {
+                const int distIK = dist[i * nodesNum + k];
+                if(distIK == infinity)
+                {
+                    continue;
+                }
+
+                for(int j = 0; j < nodesNum; j++)
+                {
+                    if(rowK[j] == infinity)
+                    {
+                        continue;
+                    }
+
+                    const int newDist = distIK + rowK[j];
+                    if(dist[i * nodesNum + j] > newDist)
+                    {
+                        dist[i * nodesNum + j] = newDist;
+                        next[i * nodesNum + j] = next[i * nodesNum + k];
+                    }
+                }
+            }
+
+            syncPoint.arrive_and_wait();
+        }
+
+        for(int k = 0; k < nodesNum; k++)
+        {
+            shouldStopRound(isCallingThread);
+            std::copy(dist + k * nodesNum, dist + (k + 1) * nodesNum, rowK.begin());
+            syncPoint.arrive_and_wait();
+
+            if(stopped.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            for(qsizetype i = firstRow; i < endRow; i++)
+            {
+                const int distIK = dist[i * nodesNum + k];
+                if(distIK == infinity)
+                {
+                    continue;
+                }
+
+                for(int j = 0; j < nodesNum; j++)
+                {
+                    if(dist[i * nodesNum + j] == -infinity || rowK[j] == infinity)
+                    {
+                        continue;
+                    }
+
+                    if(dist[i * nodesNum + j] > distIK + rowK[j])
+                    {
+                        dist[i * nodesNum + j] = -infinity;
+                        next[i * nodesNum + j] = -1;
+                    }
+                }
+            }
+
+            syncPoint.arrive_and_wait();
+        }
+    };
+
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(threadsNum - 1);
+
+        for(int t = 1; t < threadsNum; t++)
+        {
+            const qsizetype firstRow = std::min(t * rowsPerThread, nodesNum);
+            workers.emplace_back(relaxRows, firstRow, std::min(firstRow + rowsPerThread, nodesNum), false);
+        }
+
+        relaxRows(0, std::min(rowsPerThread, nodesNum), true);
+    }
+
+    if(stopped.load(std::memory_order_relaxed))
+    {
+        resultNodes.clear();
+        resultValue = infinity;
+        return;
+    }
+
+    QList<int> resultPath;
+
+    const int start = 0;
+    const int end = nodesNum - 1;
+
+    int at = start;
+    while(at != end && at != -1)
+    {
+        resultPath.append(at);
+        at = next[at * nodesNum + end];
+    }
+
+    if(at == end)
+    {
+        resultPath.append(end);
+    }
+    else
+    {
+        resultPath.clear();
+    }
+
+    resultNodes = std::move(resultPath);
+    resultValue = dist[start * nodesNum + end];
 }
 
 static const int UNVISITED = -1;
@@ -868,6 +2367,9 @@ void SCCsAlgorithm::execute()
     QList<int> visitTime(nodesNum, UNVISITED);
     QStack<int> stack;
 
+    time = 0;
+    sccCount = 0;
+
     for(int i = 0; i < nodesNum; i++)
     {
         if(visitTime[i] == UNVISITED)
@@ -875,20 +2377,29 @@ void SCCsAlgorithm::execute()
             SCCsHelper(i, visitTime, stack, low);
         }
     }
+
+    resultNodes = std::move(low);
+    resultValue = sccCount;
 }
 
 void SCCsAlgorithm::SCCsHelper(int begin, QList<int> &visitTime, QStack<int> &stack, QList<int> &low)
 {
+    BENCHMARK_COUNTER("DFS calls", Qt::darkMagenta)
+
     visitTime[begin] = low[begin] = time++;
     stack.push(begin);
 
     auto forEachNeighbour = [&](int value, int neighbour, int weight)
     {
+        BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
         if(visitTime[neighbour] == UNVISITED)
         {
             SCCsHelper(neighbour, visitTime, stack, low);
         }
 
+        BENCHMARK_COUNTER_ADD("stack elements scanned", Qt::red, stack.size())
+
         if(stack.contains(neighbour))
         {
             low[value] = std::min(low[value], low[neighbour]);
@@ -932,8 +2443,16 @@ void TravelingSalesmanProblemAlgorithmHash::execute()
     QHash<Index, int> minDistances;
     QHash<Index, int> parents;
 
-    for(const QSet<int>& combination : combinations)
+    for(qsizetype c = 0; c < combinations.size(); ++c)
     {
+        if(c % BenchmarkCancellationToken::PollInterval == 0 && cancellationToken.shouldStop())
+        {
+            resultNodes.clear();
+            return;
+        }
+
+        const QSet<int>& combination = combinations.at(c);
+
         int minDistance = INF;
         for(int i = 1; i < nodesNum; i++)
         {
@@ -987,6 +2506,18 @@ void TravelingSalesmanProblemAlgorithmHash::execute()
             parents[index] = end;
         }
     }
+
+    resultNodes = buildResultPath(index, parents);
+}
+
+qint64 TravelingSalesmanProblemAlgorithmHash::getValidationValue() const
+{
+    return getTourCost(graph, resultNodes);
+}
+
+QString TravelingSalesmanProblemAlgorithmHash::getValidationGroup() const
+{
+    return ValidationGroups::TravelingSalesman;
 }
 
 QList<int> TravelingSalesmanProblemAlgorithmHash::buildResultPath(const Index& index, const QHash<Index, int> &parents)
@@ -1077,8 +2608,15 @@ void TravelingSalesmanProblemAlgorithmBitmask::execute()
         QList<int> combinations;
         generateCombinations(r, combinations);
 
-        for(int combination : combinations)
+        for(qsizetype c = 0; c < combinations.size(); ++c)
         {
+            if(c % BenchmarkCancellationToken::PollInterval == 0 && cancellationToken.shouldStop())
+            {
+                resultNodes.clear();
+                return;
+            }
+
+            const int combination = combinations.at(c);
             if(isNotInCombination(0, combination))
             {
                 continue;
@@ -1110,7 +2648,17 @@ void TravelingSalesmanProblemAlgorithmBitmask::execute()
         }
     }
 
-    buildResultPath(memo);
+    resultNodes = buildResultPath(memo);
+}
+
+qint64 TravelingSalesmanProblemAlgorithmBitmask::getValidationValue() const
+{
+    return getTourCost(graph, resultNodes);
+}
+
+QString TravelingSalesmanProblemAlgorithmBitmask::getValidationGroup() const
+{
+    return ValidationGroups::TravelingSalesman;
 }
 
 bool TravelingSalesmanProblemAlgorithmBitmask::isNotInCombination(int i, int combination) const
@@ -1214,7 +2762,7 @@ void EulerianPathAlgorithm::execute()
 
     bool pathExist;
     {
-        //BENCHMARK_SCOPED_TIMER("doesEulerianPathExist", Qt::red, false)
+        BENCHMARK_SCOPED_TIMER("doesEulerianPathExist", Qt::magenta, AggregationMode::Sum)
 
         pathExist = doesEulerianPathExist(inDegrees, outDegrees);
     }
@@ -1223,14 +2771,14 @@ void EulerianPathAlgorithm::execute()
     {
         QList<int> eulerianPath;
         {
-            //BENCHMARK_SCOPED_TIMER("reserve(graph->getEdgesNum() + 1)", Qt::blue, false)
+            BENCHMARK_SCOPED_TIMER("reserve(graph->getEdgesNum() + 1)", Qt::blue, AggregationMode::Sum)
 
             eulerianPath.reserve(graph->getEdgesNum() + 1);
         }
 
         int start;
         {
-            //BENCHMARK_SCOPED_TIMER("findStart", Qt::black, false)
+            BENCHMARK_SCOPED_TIMER("findStart", Qt::black, AggregationMode::Sum)
 
             start = findStart(inDegrees, outDegrees);
         }
@@ -1241,14 +2789,24 @@ void EulerianPathAlgorithm::execute()
             EdgeList visitedUndirectedEdges; // It is only used with an undirected graph
             DFSHelper(start, outDegrees, eulerianPath, visitedUndirectedEdges);
         }
+
+        resultNodes = std::move(eulerianPath);
+    }
+    else
+    {
+        resultNodes.clear();
     }
 }
 
 void EulerianPathAlgorithm::DFSHelper(int begin, QList<int> &outDegrees, QList<int> &eulerianPath, EdgeList &visitedUndirectedEdges) const
 {
+    BENCHMARK_COUNTER("DFS calls", Qt::darkMagenta)
+
     {
         while(outDegrees[begin] != 0)
         {
+            BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
             const int neighbour = graph->getNeighbourAt(begin, --outDegrees[begin]);
 
             if(!graph->getIsDirected())
@@ -1381,15 +2939,19 @@ void LazyPrimMinimumSpanningTreeAlgorithm::execute()
     QList<int> spanningTree;
     spanningTree.reserve(nodesNum);
 
-    QList<bool> visited(nodesNum, false);
+    VisitedMarks& visited = workspace.takeVisitedMarks(nodesNum);
 
     PriorityQueue edgesPq;
     edgesPq.insert(0, 0);
 
     auto forEachNeighbour = [&](int value, int neighbour, int weight)
     {
-        if(!visited[neighbour])
+        BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
+        if(!visited.isVisited(neighbour))
         {
+            BENCHMARK_COUNTER("heap inserts", Qt::darkYellow)
+
             edgesPq.insert(neighbour, weight);
         }
         return true;
@@ -1399,22 +2961,21 @@ void LazyPrimMinimumSpanningTreeAlgorithm::execute()
     {
         int first;
         {
-            //BENCHMARK_SCOPED_TIMER("edgesPq.extract().first", Qt::red, AggregationMode::Max)
+            BENCHMARK_SCOPED_TIMER("edgesPq.extract().first", Qt::red, AggregationMode::Max)
 
             first = edgesPq.extract().first;
+            BENCHMARK_COUNTER("heap extracts", Qt::darkRed)
         }
 
-        if(visited[first])
+        if(!visited.tryVisit(first))
         {
             continue;
         }
 
-        visited[first] = true;
-
         spanningTree.append(first);
 
         {
-            //BENCHMARK_SCOPED_TIMER("forEachNeighbour", Qt::blue, AggregationMode::Max)
+            BENCHMARK_SCOPED_TIMER("forEachNeighbour", Qt::blue, AggregationMode::Max)
 
             graph->forEachNeighbour(first, forEachNeighbour);
         }
@@ -1424,6 +2985,8 @@ void LazyPrimMinimumSpanningTreeAlgorithm::execute()
     {
         spanningTree.clear();
     }
+
+    resultNodes = std::move(spanningTree);
 }
 
 EagerPrimMinimumSpanningTreeAlgorithm::EagerPrimMinimumSpanningTreeAlgorithm(QObject *parent)
@@ -1444,6 +3007,20 @@ bool EagerPrimMinimumSpanningTreeAlgorithm::canRunAlgorithm(QString &outInfo) co
     return false;
 }
 
+void EagerPrimMinimumSpanningTreeAlgorithm::prepareGraphForExecution(Graph *testGraph)
+{
+    GraphAlgorithm::prepareGraphForExecution(testGraph);
+
+    edgesPq.reset(testGraph->getNodesNum());
+}
+
+void EagerPrimMinimumSpanningTreeAlgorithm::releaseScratchMemory()
+{
+    GraphAlgorithm::releaseScratchMemory();
+
+    edgesPq.release();
+}
+
 void EagerPrimMinimumSpanningTreeAlgorithm::execute()
 {
     const qsizetype nodesNum = graph->getNodesNum();
@@ -1451,15 +3028,18 @@ void EagerPrimMinimumSpanningTreeAlgorithm::execute()
     QList<int> spanningTree;
     spanningTree.reserve(nodesNum);
 
-    QList<bool> visited(nodesNum, false);
+    VisitedMarks& visited = workspace.takeVisitedMarks(nodesNum);
 
-    IndexedPriorityQueue edgesPq;
     edgesPq.insert(0, 0);
 
     auto forEachNeighbour = [&](int value, int neighbour, int weight)
     {
-        if(!visited[neighbour] && weight < edgesPq.getValue(neighbour))
+        BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
+        if(!visited.isVisited(neighbour) && weight < edgesPq.getValue(neighbour))
         {
+            BENCHMARK_COUNTER("heap insert / decrease keys", Qt::darkYellow)
+
             edgesPq.updateKey(neighbour, weight);
         }
         return true;
@@ -1469,22 +3049,21 @@ void EagerPrimMinimumSpanningTreeAlgorithm::execute()
     {
         int first;
         {
-            //BENCHMARK_SCOPED_TIMER("edgesPq.extract().first", Qt::red, AggregationMode::Max)
+            BENCHMARK_SCOPED_TIMER("edgesPq.extract().first", Qt::red, AggregationMode::Max)
 
             first = edgesPq.extract().first;
+            BENCHMARK_COUNTER("heap extracts", Qt::darkRed)
         }
 
-        if(visited[first])
+        if(!visited.tryVisit(first))
         {
             continue;
         }
 
-        visited[first] = true;
-
         spanningTree.append(first);
 
         {
-            //BENCHMARK_SCOPED_TIMER("forEachNeighbour", Qt::blue, AggregationMode::Max)
+            BENCHMARK_SCOPED_TIMER("forEachNeighbour", Qt::blue, AggregationMode::Max)
 
             graph->forEachNeighbour(first, forEachNeighbour);
         }
@@ -1494,6 +3073,8 @@ void EagerPrimMinimumSpanningTreeAlgorithm::execute()
     {
         spanningTree.clear();
     }
+
+    resultNodes = std::move(spanningTree);
 }
 
 MaxNetworkFlowAlgorithm::MaxNetworkFlowAlgorithm(QObject *parent)
@@ -1523,6 +3104,19 @@ bool MaxNetworkFlowAlgorithm::canRunAlgorithm(QString &outInfo) const
     return false;
 }
 
+QString MaxNetworkFlowAlgorithm::getValidationGroup() const
+{
+    return ValidationGroups::MaxFlow;
+}
+
+void MaxNetworkFlowAlgorithm::prepareGraphForExecution(Graph *testGraph)
+{
+    // flows are augmented in place, a repeated run has to start from an empty network again
+    static_cast<ResidualGraph*>(testGraph)->resetFlows();
+
+    resultValue = 0;
+}
+
 MaxNetworkFlowFordFulkersonAlgorithm::MaxNetworkFlowFordFulkersonAlgorithm(QObject *parent)
     : MaxNetworkFlowAlgorithm(parent)
 {
@@ -1537,38 +3131,49 @@ void MaxNetworkFlowFordFulkersonAlgorithm::execute()
         residualGraph = static_cast<const ResidualGraph*>(graph);
 
         int maxFlow = 0;
-        int visitedToken = -1;
 
-        QList<int> visited(nodesNum, 0);
+        VisitedMarks& visited = workspace.takeVisitedMarks(nodesNum);
 
         int flow = INF;
         do
         {
-            flow = DFS(0, INF, visitedToken, visited);
+            flow = DFS(0, INF, visited);
             maxFlow+=flow;
-            visitedToken++;
+
+            if(flow > 0)
+            {
+                BENCHMARK_COUNTER("augmenting paths", Qt::darkRed)
+            }
+
+            visited.clear();
         } while(flow != 0);
+
+        resultValue = maxFlow;
     }
 }
 
-int MaxNetworkFlowFordFulkersonAlgorithm::DFS(int from, int flow, int visitedToken, QList<int>& visited)
+int MaxNetworkFlowFordFulkersonAlgorithm::DFS(int from, int flow, VisitedMarks& visited)
 {
     if(from == residualGraph->getNodesNum() - 1)
     {
         return flow;
     }
 
-    visited[from] = visitedToken;
+    visited.visit(from);
 
     const auto& graphContainer = residualGraph->getGraphContainer();
     const auto& neighbours = graphContainer[from];
 
+    BENCHMARK_COUNTER("DFS calls", Qt::darkMagenta)
+
     for(const auto& edge : neighbours)
     {
-        if(visited[edge->to] != visitedToken && edge->getRemainingCapacity() > 0)
+        BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
+        if(!visited.isVisited(edge->to) && edge->getRemainingCapacity() > 0)
         {
-            visited[edge->to] = visitedToken;
-            const int bottleNeck = DFS(edge->to, std::min(flow, edge->getRemainingCapacity()), visitedToken, visited);
+            visited.visit(edge->to);
+            const int bottleNeck = DFS(edge->to, std::min(flow, edge->getRemainingCapacity()), visited);
 
             if(bottleNeck > 0)
             {
@@ -1594,28 +3199,35 @@ void MaxNetworkFlowEdmondsKarpAlgorithm::execute()
         residualGraph = static_cast<const ResidualGraph*>(graph);
 
         int maxFlow = 0;
-        int visitedToken = -1;
 
-        QList<int> visited(nodesNum, 0);
+        VisitedMarks& visited = workspace.takeVisitedMarks(nodesNum);
 
         int flow = INF;
         do
         {
-            flow = BFS(visitedToken, visited);
+            flow = BFS(visited);
             maxFlow+=flow;
-            visitedToken++;
+
+            if(flow > 0)
+            {
+                BENCHMARK_COUNTER("augmenting paths", Qt::darkRed)
+            }
+
+            visited.clear();
         } while(flow != 0);
+
+        resultValue = maxFlow;
     }
 }
 
-int MaxNetworkFlowEdmondsKarpAlgorithm::BFS(int visitedToken, QList<int>& visited)
+int MaxNetworkFlowEdmondsKarpAlgorithm::BFS(VisitedMarks& visited)
 {
     const qsizetype nodesNum = graph->getNodesNum();
 
     QQueue<int> nodeQueue;
     nodeQueue.enqueue(0);
 
-    visited[0] = visitedToken;
+    visited.visit(0);
 
     const auto& graphContainer = residualGraph->getGraphContainer();
 
@@ -1626,6 +3238,8 @@ int MaxNetworkFlowEdmondsKarpAlgorithm::BFS(int visitedToken, QList<int>& visite
     while(!nodeQueue.empty())
     {
         const int from = nodeQueue.dequeue();
+        BENCHMARK_COUNTER("nodes dequeued", Qt::darkMagenta)
+
         if(from == t)
         {
             break;
@@ -1633,9 +3247,11 @@ int MaxNetworkFlowEdmondsKarpAlgorithm::BFS(int visitedToken, QList<int>& visite
 
         for(const auto& edge : graphContainer[from])
         {
-            if(visited[edge->to] != visitedToken && edge->getRemainingCapacity() > 0)
+            BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
+            if(!visited.isVisited(edge->to) && edge->getRemainingCapacity() > 0)
             {
-                visited[edge->to] = visitedToken;
+                visited.visit(edge->to);
                 prevEdges[edge->to] = edge.get();
 
                 nodeQueue.enqueue(edge->to);
@@ -1676,9 +3292,8 @@ void MaxNetworkFlowCapacityScalingAlgorithm::execute()
         residualGraph = static_cast<const ResidualGraph*>(graph);
 
         int maxFlow = 0;
-        int visitedToken = -1;
 
-        QList<int> visited(nodesNum, 0);
+        VisitedMarks& visited = workspace.takeVisitedMarks(nodesNum);
 
         int U = -INF;
         auto forEachEdge = [&](int start, int end, int capacity)
@@ -1694,9 +3309,16 @@ void MaxNetworkFlowCapacityScalingAlgorithm::execute()
         int flow = INF;
         do
         {
-            flow = DFS(0, flow, visitedToken, visited, delta);
+            // a fresh bound every time, the flow of a failed search would cap every later phase at 0
+            flow = DFS(0, INF, visited, delta);
             maxFlow+=flow;
-            visitedToken++;
+
+            if(flow > 0)
+            {
+                BENCHMARK_COUNTER("augmenting paths", Qt::darkRed)
+            }
+
+            visited.clear();
 
             if(flow == 0)
             {
@@ -1704,27 +3326,33 @@ void MaxNetworkFlowCapacityScalingAlgorithm::execute()
             }
 
         } while(flow != 0 || delta > 0);
+
+        resultValue = maxFlow;
     }
 }
 
-int MaxNetworkFlowCapacityScalingAlgorithm::DFS(int from, int flow, int visitedToken, QList<int> &visited, int delta)
+int MaxNetworkFlowCapacityScalingAlgorithm::DFS(int from, int flow, VisitedMarks &visited, int delta)
 {
     if(from == residualGraph->getNodesNum() - 1)
     {
         return flow;
     }
 
-    visited[from] = visitedToken;
+    visited.visit(from);
 
     const auto& graphContainer = residualGraph->getGraphContainer();
     const auto& neighbours = graphContainer[from];
 
+    BENCHMARK_COUNTER("DFS calls", Qt::darkMagenta)
+
     for(const auto& edge : neighbours)
     {
-        if(visited[edge->to] != visitedToken && edge->getRemainingCapacity() >= delta)
+        BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
+        if(!visited.isVisited(edge->to) && edge->getRemainingCapacity() >= delta)
         {
-            visited[edge->to] = visitedToken;
-            const int bottleNeck = DFS(edge->to, std::min(flow, edge->getRemainingCapacity()), visitedToken, visited, delta);
+            visited.visit(edge->to);
+            const int bottleNeck = DFS(edge->to, std::min(flow, edge->getRemainingCapacity()), visited, delta);
 
             if(bottleNeck > 0)
             {
@@ -1750,9 +3378,9 @@ void MaxNetworkFlowDinicAlgorithm::execute()
         residualGraph = static_cast<const ResidualGraph*>(graph);
         int maxFlow = 0;
 
-        QList<int> level;
+        QList<int>& level = workspace.takeInts();
 
-        QList<int> next;
+        QList<int>& next = workspace.takeInts();
 
         while(BFS(level))
         {
@@ -1763,8 +3391,15 @@ void MaxNetworkFlowDinicAlgorithm::execute()
             {
                 flow = DFS(0, flow, next, level);
                 maxFlow += flow;
+
+                if(flow > 0)
+                {
+                    BENCHMARK_COUNTER("augmenting paths", Qt::darkRed)
+                }
             } while(flow != 0);
         }
+
+        resultValue = maxFlow;
     }
 }
 
@@ -1784,8 +3419,12 @@ bool MaxNetworkFlowDinicAlgorithm::BFS(QList<int>& level)
     while(!nodeQueue.empty())
     {
         const int from = nodeQueue.dequeue();
+        BENCHMARK_COUNTER("nodes dequeued", Qt::darkMagenta)
+
         for(const auto& edge : graphContainer[from])
         {
+            BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
             if(edge->getRemainingCapacity() > 0 && level[edge->to] == -1)
             {
                 level[edge->to] = level[from] + 1;
@@ -1804,10 +3443,14 @@ int MaxNetworkFlowDinicAlgorithm::DFS(int from, int flow, QList<int>& next, QLis
         return flow;
     }
 
+    BENCHMARK_COUNTER("DFS calls", Qt::darkMagenta)
+
     const auto& graphContainer = residualGraph->getGraphContainer();
 
     for(; next[from] < residualGraph->getNeighboursNum(from); next[from]++)
     {
+        BENCHMARK_COUNTER("edges scanned", Qt::darkCyan)
+
         ResidualGraph::Edge* edge = graphContainer[from][next[from]].get();
         if(edge->getRemainingCapacity() > 0 && level[edge->to] == level[from] + 1)
         {
@@ -1822,3 +3465,35 @@ int MaxNetworkFlowDinicAlgorithm::DFS(int from, int flow, QList<int>& next, QLis
 
     return 0;
 }
+
+GraphConstructionBenchmark::GraphConstructionBenchmark(GraphBuilder *builder, QObject *parent)
+    : GraphAlgorithm(parent)
+{
+    setObjectName(builder->objectName() + " Construction");
+
+    qDeleteAll(dataStructureBuilders);
+    dataStructureBuilders.clear();
+
+    builder->setParent(this);
+    dataStructureBuilders.push_back(builder);
+}
+
+void GraphConstructionBenchmark::execute()
+{
+    builtGraph.reset(dynamic_cast<Graph*>(getSelectedBuilder()->createDataStructure()));
+}
+
+void GraphConstructionBenchmark::prepareGraphForExecution(Graph *testGraph)
+{
+    builtGraph.reset();
+}
+
+bool GraphConstructionBenchmark::buildsOwnInput() const
+{
+    return true;
+}
+
+const Graph *GraphConstructionBenchmark::getBuiltGraph() const
+{
+    return builtGraph.get();
+}
@@ -2,20 +2,45 @@
 #define GRAPH_AlGORITHMS_H
 
 #include "../core/algorithm.h"
+#include "../core/algorithm_workspace.h"
+#include "../core/utils.h"
 #include "edge_list.h"
 
 #include <QQueue>
+#include <QScopedPointer>
+#include <QSharedPointer>
 #include <QSet>
 
+struct AllocationStatistics;
+struct RooflinePoint;
+class ThreadAffinityGuard;
 class ResidualGraph;
-class QComboBox;
+class GraphBuilder;
 class DataStructure;
 class GraphNode;
 class Graph;
 
+// totals of a sweep that outlive its points, stored in the sweep state of checkpoints
+struct GraphSweepTotals
+{
+    explicit GraphSweepTotals(int representationsNum = 0);
+
+    qreal buildCycles = 0.0;
+    QList<qreal> measuredCycles; // per representation
+    QList<size_t> resultChecksums; // per representation
+    QStringList validationMismatches;
+
+    QJsonObject toJsonObject() const;
+    static GraphSweepTotals fromJsonObject(const QJsonObject& jsonObject, int representationsNum);
+};
+
 class GraphAlgorithm : public Algorithm
 {
     Q_OBJECT
+
+    Q_PROPERTY(bool regenerateGraphPerRepetition READ getRegenerateGraphPerRepetition WRITE setRegenerateGraphPerRepetition NOTIFY regenerateGraphPerRepetitionChanged FINAL)
+    Q_PROPERTY(bool compareRepresentations READ getCompareRepresentations WRITE setCompareRepresentations NOTIFY compareRepresentationsChanged FINAL)
+    Q_PROPERTY(bool validateResults READ getValidateResults WRITE setValidateResults NOTIFY validateResultsChanged FINAL)
 public:
     explicit GraphAlgorithm(QObject* parent = nullptr);
     virtual ~GraphAlgorithm() = 0;
@@ -26,17 +51,101 @@ public:
     void run() override;
     qreal calculateXForCurrentIteration() const override;
 
+    // with compareRepresentations the builder has to offer more than one graph implementation,
+    // with validateResults the algorithm has to belong to a validation group
+    bool canRunBenchmark(QString& outInfo) const override;
+
+    // problem solved by every algorithm of the group, empty when the algorithm has no equivalent algorithms
+    virtual QString getValidationGroup() const;
+
 #ifdef QT_DEBUG
     void debugRun() override;
 #endif
 
-    DataStructureBuilder* getSelectedBuilder() const;
+    bool getRegenerateGraphPerRepetition() const;
+    void setRegenerateGraphPerRepetition(bool newRegenerateGraphPerRepetition);
+
+    bool getCompareRepresentations() const;
+    void setCompareRepresentations(bool newCompareRepresentations);
+
+    bool getValidateResults() const;
+    void setValidateResults(bool newValidateResults);
+
+signals:
+    void regenerateGraphPerRepetitionChanged();
+    void compareRepresentationsChanged();
+    void validateResultsChanged();
 
 protected:
+    // called before every execute, restores state that execute may have changed in the graph
+    virtual void prepareGraphForExecution(Graph* testGraph);
+
+    void prepareExecution(Graph* testGraph);
+
+    virtual void releaseScratchMemory();
+
+    /**
+     * Strong scaling on one graph of iterationsNumber build iterations and weak scaling on graphs growing with the threads,
+     * for 1..maxThreadsNumber threads. Finishes with speedup, efficiency, Karp-Flatt and weak scaling efficiency series.
+     */
+    void runThreadScaling();
+
+    // median wall time in milliseconds, the cycle counter does not see the threads of a parallel execute
+    qreal measureWallTime(Graph* testGraph);
+
+    void setUpRunInfo(BenchmarkRunInfo& runInfo, const GraphBuilder* graphBuilder, const QString& startTime) const;
+
+    bool restoreCheckpointSettings(const BenchmarkCheckpoint& checkpoint, QString& outInfo) override;
+    BenchmarkCheckpoint captureCheckpointSettings() const override;
+
+    QList<AlgorithmBenchmarkResult> createSweepResults(const AlgorithmBenchmarkResult& baseResultData, const QStringList& representations) const;
+    QList<AlgorithmBenchmarkResult> restoreSweepResults(const BenchmarkCheckpoint& checkpoint, const QStringList& representations) const;
+    QString saveCheckpoint(const QList<AlgorithmBenchmarkResult>& results, quint64 inputSeed, int nextIteration, const GraphSweepTotals& totals) const;
+    void takeBackPoint(QList<AlgorithmBenchmarkResult>& results, int truncatedRepresentation) const;
+    ComplexityVariables buildPointGraphs(GraphBuilder* graphBuilder, int graphsNum, QList<QSharedPointer<Graph>>& outTestGraphs, qreal& outBuildCycles) const;
+    QList<QSharedPointer<Graph>> convertGraphs(const GraphBuilder* graphBuilder, const QList<QSharedPointer<Graph>>& testGraphs, const QString& implementation) const;
+    void appendRooflinePoints(AlgorithmBenchmarkResult& resultData, const Graph* testGraph, const BenchmarkStatistics& statistics, RooflinePoint& outLastPoint) const;
+    void appendRooflineInfo(AlgorithmBenchmarkResult& resultData, const RooflinePoint& lastPoint) const;
+    void appendValidationInfo(QString& infoText, const QStringList& mismatches, const QStringList& skippedEquivalents, int pointsNum) const;
+
+    // execute builds the graph it is measured on, run() builds no test graphs and takes the input of a point from getBuiltGraph
+    virtual bool buildsOwnInput() const;
+    virtual const Graph* getBuiltGraph() const;
+    BenchmarkStatistics measurePoint(const QList<QSharedPointer<Graph>>& testGraphs, AlgorithmBenchmarkResult& resultData, ThreadAffinityGuard& affinityGuard);
+    void prepareCaches(Graph* testGraph, ThreadAffinityGuard& affinityGuard);
+    void appendAllocationPoints(AlgorithmBenchmarkResult& resultData, const AllocationStatistics& allocations, int runsNum) const;
+    size_t getResultChecksum() const;
+    virtual qint64 getValidationValue() const;
+
+    // new instances owned by the caller, the algorithms that cannot run on the graphs of the selected builder are described in outSkipped
+    QList<GraphAlgorithm*> createEquivalentAlgorithms(QStringList& outSkipped) const;
+
+    void validatePoint(Graph* testGraph, const QList<GraphAlgorithm*>& equivalentAlgorithms, QStringList& outMismatches);
+
+    // bytes touched and operations done by the last execute on testGraph, false when the algorithm has no estimate
+    virtual bool estimateTraffic(const Graph* testGraph, qreal& outBytes, qreal& outOperations) const;
+
     const Graph* graph;
 
+    AlgorithmWorkspace workspace;
+
+    // execute moves its result here instead of dropping it, so the compiler cannot remove the work producing it
+    QList<int> resultNodes;
+    qint64 resultValue;
+
+    bool regenerateGraphPerRepetition;
+    bool compareRepresentations;
+    bool validateResults;
+    qreal currentX;
+    ComplexityVariables currentInput; // the input of the point being measured, currentX is evaluated from it
+
+    const char* executeTraceName;
+
+    QString currentCacheMode;
+    int builderCore;
+    int executionCore;
+
 private:
-    QComboBox* builderComboBox;
     QWidget* builderPropertiesWidget;
 };
 
@@ -48,6 +157,7 @@ public:
 
 protected:
     void execute() override;
+    bool estimateTraffic(const Graph* testGraph, qreal& outBytes, qreal& outOperations) const override;
 };
 
 class BFSRecursive : public GraphAlgorithm
@@ -58,6 +168,7 @@ public:
 
 protected:
     void execute() override;
+    bool estimateTraffic(const Graph* testGraph, qreal& outBytes, qreal& outOperations) const override;
     void BFSRecursiveHelper(QQueue<int>& nodeQueue, std::function<bool(int, int, int)> forEachNeighbourFunc);
 };
 
@@ -79,7 +190,7 @@ public:
 
 protected:
     void execute() override;
-    void DFSHelper(int begin, QList<bool>& visited);
+    void DFSHelper(int begin, VisitedMarks& visited);
 };
 
 class TreeCenters : public GraphAlgorithm
@@ -102,9 +213,12 @@ public:
 
     static void getResult(const Graph* graph, QStack<int>& topologicalOrder);
 
+    QString getValidationGroup() const override;
+
 protected:
     void execute() override;
-    void TopologicalSortHelper(int begin, QList<bool>& visited, QStack<int>& topologicalOrder);
+    qint64 getValidationValue() const override;
+    void TopologicalSortHelper(int begin, VisitedMarks& visited, QStack<int>& topologicalOrder);
 };
 
 class KahnsAlgorithm : public GraphAlgorithm
@@ -115,8 +229,11 @@ public:
 
     bool canRunAlgorithm(QString& outInfo) const override;
 
+    QString getValidationGroup() const override;
+
 protected:
     void execute() override;
+    qint64 getValidationValue() const override;
 };
 
 class LazyDijkstraAlgorithm : public GraphAlgorithm
@@ -127,6 +244,8 @@ public:
 
     bool canRunAlgorithm(QString& outInfo) const override;
 
+    QString getValidationGroup() const override;
+
 protected:
     void execute() override;
 };
@@ -139,8 +258,15 @@ public:
 
     bool canRunAlgorithm(QString& outInfo) const override;
 
+    QString getValidationGroup() const override;
+
 protected:
     void execute() override;
+
+    void prepareGraphForExecution(Graph* testGraph) override;
+    void releaseScratchMemory() override;
+
+    DenseIndexedPriorityQueue<int> nodeDistancePairs;
 };
 
 class BellmanFordAlgorithm : public GraphAlgorithm
@@ -154,13 +280,17 @@ public:
     bool getBreakIfNoChange() const;
     void setBreakIfNoChange(bool newBreakIfNoChange);
 
+    QString getValidationGroup() const override;
+
 signals:
     void breakIfNoChangeChanged();
 
 protected:
     void execute() override;
+    bool estimateTraffic(const Graph* testGraph, qreal& outBytes, qreal& outOperations) const override;
 
     bool breakIfNoChange;
+    int sweepsNum; // passes over all edges in the last execute, the negative cycle pass included
 };
 
 class FloydWarshallAlgorithm : public GraphAlgorithm
@@ -170,6 +300,21 @@ class FloydWarshallAlgorithm : public GraphAlgorithm
 public:
     explicit FloydWarshallAlgorithm(QObject* parent = nullptr);
 
+protected:
+    void execute() override;
+    bool estimateTraffic(const Graph* testGraph, qreal& outBytes, qreal& outOperations) const override;
+};
+
+// Rows of the distance matrix are split between threadsNumber threads, which meet at a barrier after every intermediate node
+class ParallelFloydWarshallAlgorithm : public GraphAlgorithm
+{
+    Q_OBJECT
+
+public:
+    explicit ParallelFloydWarshallAlgorithm(QObject* parent = nullptr);
+
+    bool isParallel() const override;
+
 protected:
     void execute() override;
 };
@@ -208,8 +353,11 @@ public:
         }
     };
 
+    QString getValidationGroup() const override;
+
 protected:
     void execute() override;
+    qint64 getValidationValue() const override;
     QList<int> buildResultPath(const Index& index, const QHash<Index, int> &parents);
 
     int getDistanceTo(int end, const Index& index, const QHash<Index, int>& minDistances) const;
@@ -235,8 +383,11 @@ class TravelingSalesmanProblemAlgorithmBitmask : public GraphAlgorithm
 public:
     explicit TravelingSalesmanProblemAlgorithmBitmask(QObject* parent = nullptr);
 
+    QString getValidationGroup() const override;
+
 protected:
     void execute() override;
+    qint64 getValidationValue() const override;
     bool isNotInCombination(int i, int combination) const;
     QList<int> buildResultPath(const QList<QList<int>> &memo);
 
@@ -282,6 +433,10 @@ public:
 protected:
     void execute() override;
 
+    void prepareGraphForExecution(Graph* testGraph) override;
+    void releaseScratchMemory() override;
+
+    DenseIndexedPriorityQueue<int> edgesPq;
 };
 
 class MaxNetworkFlowAlgorithm : public GraphAlgorithm
@@ -292,7 +447,11 @@ public:
 
     bool canRunAlgorithm(QString& outInfo) const override;
 
+    QString getValidationGroup() const override;
+
 protected:
+    void prepareGraphForExecution(Graph* testGraph) override;
+
      const ResidualGraph* residualGraph;
 };
 
@@ -305,7 +464,7 @@ public:
 protected:
     void execute() override;
 
-    int DFS(int from, int flow, int visitedToken, QList<int>& visited);
+    int DFS(int from, int flow, VisitedMarks& visited);
 };
 
 class MaxNetworkFlowEdmondsKarpAlgorithm : public MaxNetworkFlowAlgorithm
@@ -317,7 +476,7 @@ public:
 protected:
     void execute() override;
 
-    int BFS(int visitedToken, QList<int>& visited);
+    int BFS(VisitedMarks& visited);
 };
 
 class MaxNetworkFlowCapacityScalingAlgorithm : public MaxNetworkFlowAlgorithm
@@ -329,7 +488,7 @@ public:
 protected:
     void execute() override;
 
-    int DFS(int from, int flow, int visitedToken, QList<int>& visited, int delta);
+    int DFS(int from, int flow, VisitedMarks& visited, int delta);
 
     const ResidualGraph* residualGraph;
 };
@@ -347,4 +506,23 @@ protected:
     int DFS(int from, int flow, QList<int>& next, QList<int>& level);
 };
 
+// Measures the builder itself, execute() builds one graph of the current size
+class GraphConstructionBenchmark : public GraphAlgorithm
+{
+    Q_OBJECT
+public:
+    // takes ownership of the builder
+    explicit GraphConstructionBenchmark(GraphBuilder* builder, QObject* parent = nullptr);
+
+protected:
+    void execute() override;
+
+    void prepareGraphForExecution(Graph* testGraph) override;
+
+    bool buildsOwnInput() const override;
+    const Graph* getBuiltGraph() const override;
+
+    QScopedPointer<Graph> builtGraph;
+};
+
 #endif // GRAPH_AlGORITHMS_H
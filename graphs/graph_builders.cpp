@@ -1,6 +1,7 @@
 #include "graph_builders.h"
 
 #include "../core/property_editor_factory.h"
+#include "../core/utils.h"
 
 #include "graph.h"
 
@@ -47,10 +48,15 @@ void GraphBuilder::appendPropertiesInfo(QString &infoText)
 }
 
 Graph *GraphBuilder::createGraph() const
+{
+    return createGraph(selectedImplementation);
+}
+
+Graph *GraphBuilder::createGraph(const QString &implementation) const
 {
     auto createGraphFunc = std::find_if(dataStructures.begin(), dataStructures.end(), [&](const QPair<QString, std::function<DataStructure*()>>& pair)
     {
-        return pair.first == selectedImplementation;
+        return pair.first == implementation;
     })->second;
 
     Graph* graph = qobject_cast<Graph*>(createGraphFunc());
@@ -75,6 +81,44 @@ void GraphBuilder::setIsGraphDirected(bool newIsGraphDirected)
     emit isGraphDirectedChanged();
 }
 
+const QString &GraphBuilder::getSelectedImplementation() const
+{
+    return selectedImplementation;
+}
+
+bool GraphBuilder::selectImplementation(const QString &implementation)
+{
+    if(!getImplementations().contains(implementation))
+    {
+        return false;
+    }
+
+    selectedImplementation = implementation;
+    return true;
+}
+
+QStringList GraphBuilder::getImplementations() const
+{
+    QStringList implementations;
+    implementations.reserve(dataStructures.size());
+
+    for(const auto& dataStructure : dataStructures)
+    {
+        implementations.push_back(dataStructure.first);
+    }
+
+    return implementations;
+}
+
+Graph *GraphBuilder::convertGraph(const Graph *source, const QString &implementation) const
+{
+    Graph* graph = createGraph(implementation);
+    graph->setIsDirected(source->getIsDirected());
+    graph->copyFrom(*source);
+
+    return graph;
+}
+
 int GraphBuilder::getMinWeight() const
 {
     return minWeight;
@@ -165,12 +209,12 @@ DataStructure *GridGraphBuilder::createDataStructure()
 
             if(j > 0)
             {
-                graph->addEdge(prevValue, value, QRandomGenerator::global()->bounded(minWeight, maxWeight + 1));
+                graph->addEdge(prevValue, value, Utils::getInputGenerator().bounded(minWeight, maxWeight + 1));
             }
 
             if(i > 0)
             {
-                graph->addEdge(prevRow[j], value, QRandomGenerator::global()->bounded(minWeight, maxWeight + 1));
+                graph->addEdge(prevRow[j], value, Utils::getInputGenerator().bounded(minWeight, maxWeight + 1));
             }
 
             prevRow[j] = value;
@@ -200,8 +244,8 @@ DataStructure *TreeGraphBuilder::createDataStructure()
 
     for(int i = 1; i <= buildIterations * 2; i+=2)
     {
-        graph->addEdge(i, parent, QRandomGenerator::global()->bounded(minWeight, maxWeight + 1));
-        graph->addEdge(i + 1, parent, QRandomGenerator::global()->bounded(minWeight, maxWeight + 1));
+        graph->addEdge(i, parent, Utils::getInputGenerator().bounded(minWeight, maxWeight + 1));
+        graph->addEdge(i + 1, parent, Utils::getInputGenerator().bounded(minWeight, maxWeight + 1));
 
         parent = i;
     }
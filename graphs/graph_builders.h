@@ -3,6 +3,8 @@
 
 #include "../core/data_structure_builder.h"
 
+#include <QStringList>
+
 class Graph;
 
 class GraphBuilder : public DataStructureBuilder
@@ -28,6 +30,19 @@ public:
     int getMaxWeight() const;
     void setMaxWeight(int newMaxWeight);
 
+    const QString& getSelectedImplementation() const;
+
+    // false when the builder has no such implementation
+    bool selectImplementation(const QString& implementation);
+
+    QStringList getImplementations() const;
+
+    // copy of source in the given implementation, same direction, nodes and edges
+    Graph* convertGraph(const Graph* source, const QString& implementation) const;
+
+    // empty graph of the selected implementation and direction
+    Graph* createGraph() const;
+
     int buildIterations;
 
 signals:
@@ -36,7 +51,7 @@ signals:
     void maxWeightChanged();
 
 protected:
-    Graph* createGraph() const;
+    Graph* createGraph(const QString& implementation) const;
 
     bool isGraphDirected;
     int minWeight;
@@ -0,0 +1,406 @@
+#include "graph_microbenchmarks.h"
+#include "graph.h"
+
+#include "../core/utils.h"
+
+#include "edge_list.h"
+
+#include <QRandomGenerator>
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+    // fixed, so the random order of a size is the same in every run and can be compared between runs
+    constexpr quint32 QueryOrderSeed = 0x9e3779b9;
+}
+
+GraphMicrobenchmark::GraphMicrobenchmark(QObject *parent)
+    : GraphAlgorithm(parent)
+    , randomAccess(false)
+{
+
+}
+
+GraphMicrobenchmark::~GraphMicrobenchmark()
+{
+
+}
+
+bool GraphMicrobenchmark::getRandomAccess() const
+{
+    return randomAccess;
+}
+
+void GraphMicrobenchmark::setRandomAccess(bool newRandomAccess)
+{
+    if (randomAccess == newRandomAccess)
+    {
+        return;
+    }
+
+    randomAccess = newRandomAccess;
+    emit randomAccessChanged();
+}
+
+template<typename T>
+void GraphMicrobenchmark::shuffleQueries(QList<T> &queries) const
+{
+    if(randomAccess)
+    {
+        QRandomGenerator generator(QueryOrderSeed);
+        std::shuffle(queries.begin(), queries.end(), generator);
+    }
+}
+
+void GraphMicrobenchmark::prepareGraphForExecution(Graph *testGraph)
+{
+    GraphAlgorithm::prepareGraphForExecution(testGraph);
+
+    collectQueries(testGraph);
+}
+
+void GraphMicrobenchmark::collectQueries(Graph *testGraph)
+{
+    queries.clear();
+    queries.reserve(testGraph->getEdgesNum() * (testGraph->getIsDirected() ? 1 : 2));
+
+    testGraph->forEachEdge([this](int from, int to, int weight)
+    {
+        queries.append(EdgeQuery{from, to, weight});
+        return true;
+    });
+
+    shuffleQueries(queries);
+}
+
+GraphLookupMicrobenchmark::GraphLookupMicrobenchmark(QObject *parent)
+    : GraphMicrobenchmark(parent)
+    , lookupMisses(false)
+    , lookupGraph(nullptr)
+{
+
+}
+
+GraphLookupMicrobenchmark::~GraphLookupMicrobenchmark()
+{
+
+}
+
+bool GraphLookupMicrobenchmark::getLookupMisses() const
+{
+    return lookupMisses;
+}
+
+void GraphLookupMicrobenchmark::setLookupMisses(bool newLookupMisses)
+{
+    if (lookupMisses == newLookupMisses)
+    {
+        return;
+    }
+
+    lookupMisses = newLookupMisses;
+    emit lookupMissesChanged();
+}
+
+void GraphLookupMicrobenchmark::collectQueries(Graph *testGraph)
+{
+    lookupGraph = testGraph;
+
+    GraphMicrobenchmark::collectQueries(testGraph);
+
+    if(!lookupMisses)
+    {
+        return;
+    }
+
+    // every hit becomes a miss from the same node, so both read the same rows and lists
+    const int nodesNum = static_cast<int>(testGraph->getNodesNum());
+    QList<EdgeQuery> missQueries;
+    missQueries.reserve(queries.size());
+
+    for(const EdgeQuery& query : std::as_const(queries))
+    {
+        for(int probe = 1; probe <= MissProbesNum; ++probe)
+        {
+            const int to = (query.to + probe) % nodesNum;
+            if(to != query.from && !testGraph->hasEdgeTo(query.from, to))
+            {
+                missQueries.append(EdgeQuery{query.from, to, query.weight});
+                break;
+            }
+        }
+    }
+
+    queries = std::move(missQueries);
+}
+
+AddEdgeMicrobenchmark::AddEdgeMicrobenchmark(QObject *parent)
+    : GraphMicrobenchmark(parent)
+{
+    setObjectName("Add Edge");
+}
+
+void AddEdgeMicrobenchmark::execute()
+{
+    for(const EdgeQuery& query : std::as_const(queries))
+    {
+        insertionGraph->addEdge(query.from, query.to, query.weight);
+    }
+
+    resultValue = insertionGraph->getEdgesNum();
+}
+
+void AddEdgeMicrobenchmark::prepareGraphForExecution(Graph *testGraph)
+{
+    GraphMicrobenchmark::prepareGraphForExecution(testGraph);
+
+    insertionGraph.reset(testGraph->createEmptyGraph());
+
+    const qsizetype nodesNum = testGraph->getNodesNum();
+    for(qsizetype i = 0; i < nodesNum; ++i)
+    {
+        insertionGraph->addNode();
+    }
+}
+
+HasEdgeToMicrobenchmark::HasEdgeToMicrobenchmark(QObject *parent)
+    : GraphLookupMicrobenchmark(parent)
+{
+    setObjectName("Has Edge To");
+}
+
+void HasEdgeToMicrobenchmark::execute()
+{
+    qint64 foundEdgesNum = 0;
+    for(const EdgeQuery& query : std::as_const(queries))
+    {
+        foundEdgesNum += lookupGraph->hasEdgeTo(query.from, query.to) ? 1 : 0;
+    }
+
+    resultValue = foundEdgesNum;
+}
+
+GetEdgeWeightMicrobenchmark::GetEdgeWeightMicrobenchmark(QObject *parent)
+    : GraphLookupMicrobenchmark(parent)
+{
+    setObjectName("Get Edge Weight");
+}
+
+void GetEdgeWeightMicrobenchmark::execute()
+{
+    qint64 weightsSum = 0;
+    for(const EdgeQuery& query : std::as_const(queries))
+    {
+        weightsSum += graph->getEdgeWeight(query.from, query.to);
+    }
+
+    resultValue = weightsSum;
+}
+
+ForEachNeighbourMicrobenchmark::ForEachNeighbourMicrobenchmark(QObject *parent)
+    : GraphMicrobenchmark(parent)
+{
+    setObjectName("For Each Neighbour");
+}
+
+void ForEachNeighbourMicrobenchmark::execute()
+{
+    qint64 weightsSum = 0;
+    auto addWeight = [&weightsSum](int start, int neighbour, int weight)
+    {
+        weightsSum += weight;
+        return true;
+    };
+
+    for(int node : std::as_const(queryNodes))
+    {
+        graph->forEachNeighbour(node, addWeight);
+    }
+
+    resultValue = weightsSum;
+}
+
+void ForEachNeighbourMicrobenchmark::collectQueries(Graph *testGraph)
+{
+    queryNodes.resize(testGraph->getNodesNum());
+    std::iota(queryNodes.begin(), queryNodes.end(), 0);
+
+    shuffleQueries(queryNodes);
+}
+
+GetNeighbourAtMicrobenchmark::GetNeighbourAtMicrobenchmark(QObject *parent)
+    : ForEachNeighbourMicrobenchmark(parent)
+{
+    setObjectName("Get Neighbour At");
+}
+
+void GetNeighbourAtMicrobenchmark::execute()
+{
+    qint64 neighboursSum = 0;
+    for(int node : std::as_const(queryNodes))
+    {
+        const qsizetype neighboursNum = graph->getNeighboursNum(node);
+        for(int at = 0; at < neighboursNum; ++at)
+        {
+            neighboursSum += graph->getNeighbourAt(node, at);
+        }
+    }
+
+    resultValue = neighboursSum;
+}
+
+ForEachEdgeMicrobenchmark::ForEachEdgeMicrobenchmark(QObject *parent)
+    : GraphAlgorithm(parent)
+{
+    setObjectName("For Each Edge");
+}
+
+void ForEachEdgeMicrobenchmark::execute()
+{
+    qint64 weightsSum = 0;
+    graph->forEachEdge([&weightsSum](int start, int end, int weight)
+    {
+        weightsSum += weight;
+        return true;
+    });
+
+    resultValue = weightsSum;
+}
+
+PriorityQueueMicrobenchmark::PriorityQueueMicrobenchmark(QObject *parent)
+    : GraphMicrobenchmark(parent)
+{
+    setObjectName("Priority Queue");
+}
+
+void PriorityQueueMicrobenchmark::execute()
+{
+    PriorityQueue priorityQueue;
+    priorityQueue.reserve(queries.size());
+
+    for(const EdgeQuery& query : std::as_const(queries))
+    {
+        priorityQueue.insert(query.to, query.weight);
+    }
+
+    qint64 prioritiesSum = 0;
+    while(!priorityQueue.empty())
+    {
+        prioritiesSum += priorityQueue.extract().second;
+    }
+
+    resultValue = prioritiesSum;
+}
+
+void PriorityQueueMicrobenchmark::collectQueries(Graph *testGraph)
+{
+    GraphMicrobenchmark::collectQueries(testGraph);
+
+    if(!randomAccess)
+    {
+        std::stable_sort(queries.begin(), queries.end(), [](const EdgeQuery& a, const EdgeQuery& b)
+        {
+            return a.weight < b.weight;
+        });
+    }
+}
+
+IndexedPriorityQueueMicrobenchmark::IndexedPriorityQueueMicrobenchmark(QObject *parent)
+    : PriorityQueueMicrobenchmark(parent)
+{
+    setObjectName("Indexed Priority Queue");
+}
+
+void IndexedPriorityQueueMicrobenchmark::execute()
+{
+    IndexedPriorityQueue priorityQueue;
+
+    for(const EdgeQuery& query : std::as_const(queries))
+    {
+        if(priorityQueue.getValue(query.to) > query.weight)
+        {
+            priorityQueue.updateKey(query.to, query.weight);
+        }
+    }
+
+    qint64 prioritiesSum = 0;
+    while(!priorityQueue.empty())
+    {
+        prioritiesSum += priorityQueue.extract().second;
+    }
+
+    resultValue = prioritiesSum;
+}
+
+DenseIndexedPriorityQueueMicrobenchmark::DenseIndexedPriorityQueueMicrobenchmark(QObject *parent)
+    : PriorityQueueMicrobenchmark(parent)
+{
+    setObjectName("Dense Indexed Priority Queue");
+}
+
+void DenseIndexedPriorityQueueMicrobenchmark::execute()
+{
+    DenseIndexedPriorityQueue<int> priorityQueue(graph->getNodesNum());
+
+    for(const EdgeQuery& query : std::as_const(queries))
+    {
+        if(priorityQueue.getValue(query.to) > query.weight)
+        {
+            priorityQueue.updateKey(query.to, query.weight);
+        }
+    }
+
+    qint64 prioritiesSum = 0;
+    while(!priorityQueue.empty())
+    {
+        prioritiesSum += priorityQueue.extract().second;
+    }
+
+    resultValue = prioritiesSum;
+}
+
+EdgeListMicrobenchmark::EdgeListMicrobenchmark(QObject *parent)
+    : GraphLookupMicrobenchmark(parent)
+{
+    setObjectName("Edge List");
+}
+
+void EdgeListMicrobenchmark::execute()
+{
+    const bool isDirected = graph->getIsDirected();
+
+    EdgeList edgeList;
+    edgeList.reserve(storedEdges.size());
+
+    for(const EdgeQuery& storedEdge : std::as_const(storedEdges))
+    {
+        edgeList.add(storedEdge.from, storedEdge.to, isDirected);
+    }
+
+    qint64 foundEdgesNum = 0;
+    for(const EdgeQuery& query : std::as_const(queries))
+    {
+        foundEdgesNum += edgeList.contains(Edge(query.from, query.to, isDirected)) ? 1 : 0;
+    }
+
+    resultValue = foundEdgesNum;
+}
+
+void EdgeListMicrobenchmark::prepareGraphForExecution(Graph *testGraph)
+{
+    GraphLookupMicrobenchmark::prepareGraphForExecution(testGraph);
+
+    // the lookups run against every stored edge whatever lookupMisses selects
+    storedEdges.clear();
+    storedEdges.reserve(testGraph->getEdgesNum() * (testGraph->getIsDirected() ? 1 : 2));
+
+    testGraph->forEachEdge([this](int from, int to, int weight)
+    {
+        storedEdges.append(EdgeQuery{from, to, weight});
+        return true;
+    });
+
+    shuffleQueries(storedEdges);
+}
@@ -0,0 +1,197 @@
+#ifndef GRAPH_MICROBENCHMARKS_H
+#define GRAPH_MICROBENCHMARKS_H
+
+#include "graph_algorithms.h"
+
+#include <QList>
+#include <QScopedPointer>
+
+/**
+ * Measures a single primitive instead of a whole algorithm. The queries of a run are taken from the stored edges
+ * of the built graph by prepareGraphForExecution, so execute() only runs the primitive.
+ */
+class GraphMicrobenchmark : public GraphAlgorithm
+{
+    Q_OBJECT
+
+    Q_PROPERTY(bool randomAccess READ getRandomAccess WRITE setRandomAccess NOTIFY randomAccessChanged FINAL)
+public:
+    explicit GraphMicrobenchmark(QObject* parent = nullptr);
+    virtual ~GraphMicrobenchmark() = 0;
+
+    bool getRandomAccess() const;
+    void setRandomAccess(bool newRandomAccess);
+
+signals:
+    void randomAccessChanged();
+
+protected:
+    struct EdgeQuery
+    {
+        int from;
+        int to;
+        int weight;
+    };
+
+    void prepareGraphForExecution(Graph* testGraph) override;
+
+    // queries in the order forEachEdge gives them, one per stored edge
+    virtual void collectQueries(Graph* testGraph);
+
+    // the same permutation for every run and every representation of the same order, only when randomAccess is set
+    template<typename T>
+    void shuffleQueries(QList<T>& queries) const;
+
+    bool randomAccess; // queries in a fixed random order instead of the order of the representation
+
+    QList<EdgeQuery> queries;
+};
+
+// Queries existing edges or, with lookupMisses, node pairs without an edge
+class GraphLookupMicrobenchmark : public GraphMicrobenchmark
+{
+    Q_OBJECT
+
+    Q_PROPERTY(bool lookupMisses READ getLookupMisses WRITE setLookupMisses NOTIFY lookupMissesChanged FINAL)
+public:
+    explicit GraphLookupMicrobenchmark(QObject* parent = nullptr);
+    virtual ~GraphLookupMicrobenchmark() = 0;
+
+    bool getLookupMisses() const;
+    void setLookupMisses(bool newLookupMisses);
+
+signals:
+    void lookupMissesChanged();
+
+protected:
+    static constexpr int MissProbesNum = 16;
+
+    void collectQueries(Graph* testGraph) override;
+
+    bool lookupMisses;
+
+    // hasEdgeTo is not const
+    Graph* lookupGraph;
+};
+
+class AddEdgeMicrobenchmark : public GraphMicrobenchmark
+{
+    Q_OBJECT
+public:
+    explicit AddEdgeMicrobenchmark(QObject* parent = nullptr);
+
+protected:
+    void execute() override;
+
+    // an empty graph of the same representation with the nodes of testGraph receives the edges
+    void prepareGraphForExecution(Graph* testGraph) override;
+
+    QScopedPointer<Graph> insertionGraph;
+};
+
+class HasEdgeToMicrobenchmark : public GraphLookupMicrobenchmark
+{
+    Q_OBJECT
+public:
+    explicit HasEdgeToMicrobenchmark(QObject* parent = nullptr);
+
+protected:
+    void execute() override;
+};
+
+class GetEdgeWeightMicrobenchmark : public GraphLookupMicrobenchmark
+{
+    Q_OBJECT
+public:
+    explicit GetEdgeWeightMicrobenchmark(QObject* parent = nullptr);
+
+protected:
+    void execute() override;
+};
+
+// Visits the neighbours of every node, randomAccess changes the order of the nodes
+class ForEachNeighbourMicrobenchmark : public GraphMicrobenchmark
+{
+    Q_OBJECT
+public:
+    explicit ForEachNeighbourMicrobenchmark(QObject* parent = nullptr);
+
+protected:
+    void execute() override;
+    void collectQueries(Graph* testGraph) override;
+
+    QList<int> queryNodes;
+};
+
+// Reads the neighbours of every node by position, on the matrix every read scans the row up to the neighbour
+class GetNeighbourAtMicrobenchmark : public ForEachNeighbourMicrobenchmark
+{
+    Q_OBJECT
+public:
+    explicit GetNeighbourAtMicrobenchmark(QObject* parent = nullptr);
+
+protected:
+    void execute() override;
+};
+
+// A full scan in the order of the representation, there is no other access pattern
+class ForEachEdgeMicrobenchmark : public GraphAlgorithm
+{
+    Q_OBJECT
+public:
+    explicit ForEachEdgeMicrobenchmark(QObject* parent = nullptr);
+
+protected:
+    void execute() override;
+};
+
+// Inserts the edge ends with the edge weights as priorities and extracts all of them,
+// without randomAccess the priorities come in ascending order
+class PriorityQueueMicrobenchmark : public GraphMicrobenchmark
+{
+    Q_OBJECT
+public:
+    explicit PriorityQueueMicrobenchmark(QObject* parent = nullptr);
+
+protected:
+    void execute() override;
+    void collectQueries(Graph* testGraph) override;
+};
+
+// Decreases the priority of the edge ends like eager Dijkstra does and extracts all of them
+class IndexedPriorityQueueMicrobenchmark : public PriorityQueueMicrobenchmark
+{
+    Q_OBJECT
+public:
+    explicit IndexedPriorityQueueMicrobenchmark(QObject* parent = nullptr);
+
+protected:
+    void execute() override;
+};
+
+// The same decreases on the queue with a dense position array
+class DenseIndexedPriorityQueueMicrobenchmark : public PriorityQueueMicrobenchmark
+{
+    Q_OBJECT
+public:
+    explicit DenseIndexedPriorityQueueMicrobenchmark(QObject* parent = nullptr);
+
+protected:
+    void execute() override;
+};
+
+// Adds the stored edges to an EdgeList and looks every query up in it
+class EdgeListMicrobenchmark : public GraphLookupMicrobenchmark
+{
+    Q_OBJECT
+public:
+    explicit EdgeListMicrobenchmark(QObject* parent = nullptr);
+
+protected:
+    void execute() override;
+    void prepareGraphForExecution(Graph* testGraph) override;
+
+    QList<EdgeQuery> storedEdges;
+};
+
+#endif // GRAPH_MICROBENCHMARKS_H
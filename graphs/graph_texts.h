@@ -7,11 +7,14 @@ namespace GraphTexts
 {
     inline const QString DirectedGraphIsNotSupported = "Directed graph is not supported by this algorithm.";
     inline const QString UndirectedGraphIsNotSupported = "Undirected graph is not supported by this algorithm.";
+    inline const QString NegativeWeightsAreNotSupported = "Negative weights are not supported by this algorithm.";
     inline const QString EmptyGraph = "Graph is empty.";
     inline const QString StartNodeIsInvalid = "Start node is invalid.";
     inline const QString EndNodeIsInvalid = "End node is invalid.";
     inline const QString StartOrEndNodesAreInvalid = "Start or end nodes are invalid.";
     inline const QString NoMSTExists = "No MST exists";
+    inline const QString NoEquivalentAlgorithms = "Validating results needs an algorithm with equivalent algorithms to compare with.";
+    inline const QString SingleRepresentationBuilder = "Comparing representations needs a builder with more than one graph implementation.";
 }
 
 #endif // GRAPH_TEXTS_H
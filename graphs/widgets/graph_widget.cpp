@@ -243,7 +243,7 @@ bool GraphWidget::visualizeAlgorithmAction(AlgorithmVisualizer* algorithmVisuali
 
                 currentAlgorithmVisualizer = graphAlgorithmVisualizer;
 
-                currentAlgorithmVisualizer->run(this);
+                currentAlgorithmVisualizer->start(this);
             }
             else
             {
@@ -1,4 +1,6 @@
 #include "widgets/main_window.h"
+#include "core/benchmark_timers.h"
+#include "core/roofline.h"
 
 #include <QApplication>
 
@@ -7,6 +9,13 @@ int main(int argc, char *argv[])
     QApplication::setStyle("Fusion");
     QApplication a(argc, argv);
 
+#ifdef BENCHMARK_TIMERS_ENABLED
+    BenchmarkTimerRecorder::calibrateOverhead();
+#endif
+
+    // measured before any benchmark can load the machine
+    RooflineProbes::getCeilings();
+
     MainWindow w;
     w.show();
 
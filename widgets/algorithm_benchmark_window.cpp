@@ -1,22 +1,32 @@
 #include "algorithm_benchmark_window.h"
 #include "../core/algorithm.h"
 #include "../graphs/graph_algorithms.h"
+#include "../graphs/graph_builders.h"
+#include "../graphs/graph_microbenchmarks.h"
 #include "../core/algorithm_texts.h"
+#include "../core/benchmark_checkpoint.h"
+#include "../core/benchmark_comparison.h"
+#include "../core/benchmark_job_queue.h"
+#include "../core/benchmark_results_store.h"
 #include "../core/benchmark_timers.h"
+#include "../core/cache_control.h"
+#include "../core/series_downsampling.h"
 
+#include <QAreaSeries>
 #include <QStandardItemModel>
 #include <QToolBar>
 #include <QTreeView>
+#include <QTreeWidget>
+#include <QHeaderView>
 #include <QChart>
 #include <QChartView>
 #include <QLineSeries>
 #include <QThreadPool>
 #include <QCheckBox>
 #include <QMessageBox>
-#include <QFile>
-#include <QJsonArray>
-#include <QJsonObject>
-#include <QJsonDocument>
+#include <QInputDialog>
+#include <QScatterSeries>
+#include <QStatusBar>
 #include <QToolTip>
 #include <QLabel>
 #include <QPointer>
@@ -24,6 +34,7 @@
 
 AlgorithmBenchmarkWindow::AlgorithmBenchmarkWindow(QWidget *parent)
     : QMainWindow{parent}
+    , displayedPointsNum(0)
 {
     registerAlgorithms();
     setupUi();
@@ -48,36 +59,53 @@ void AlgorithmBenchmarkWindow::mousePressEvent(QMouseEvent *event)
 
 void AlgorithmBenchmarkWindow::onActionSaveTriggered()
 {
-    const auto reply = QMessageBox::question(this, "Confirmation", "Do you want to save this result and override the existing one?"
-                                             , QMessageBox::Yes | QMessageBox::No);
-
-    if(reply == QMessageBox::Yes)
-    {
-        saveSeriesToFile();
-    }
+    saveSeriesToStore();
 }
 
 void AlgorithmBenchmarkWindow::onActionLoadTriggered()
 {
-    loadSeriesFromFile();
+    loadSeriesFromStore();
 }
 
 void AlgorithmBenchmarkWindow::onActionClearTriggered()
 {
+    // live series of running benchmarks stay, removeAllSeries would delete them
+    for(QLineSeries* liveSeries : std::as_const(algorithmToLiveSeries))
+    {
+        if(chart->series().contains(liveSeries))
+        {
+            chart->removeSeries(liveSeries);
+        }
+    }
+
     chart->removeAllSeries();
     seriesToLabel.clear();
     seriesToResultData.clear();
+    seriesToBand.clear();
+
+    for(QLineSeries* liveSeries : std::as_const(algorithmToLiveSeries))
+    {
+        addSeries(liveSeries);
+    }
 }
 
 void AlgorithmBenchmarkWindow::onActionRunBenchmarkTriggered(bool isOn)
 {
     if(isOn)
     {
+        // the suite may be running the selected algorithm, a runnable cannot run twice at once
+        if(jobQueue->isRunning())
+        {
+            actionRunBenchmark->setChecked(true);
+            QMessageBox::information(this, "Info", AlgorithmTexts::SuiteRunning);
+            return;
+        }
+
         Algorithm* algorithm = getSelectedAlgorithm();
         if(algorithm)
         {
             QString outInfo;
-            if(!algorithm->canRunAlgorithm(outInfo))
+            if(!algorithm->canRunBenchmark(outInfo))
             {
                 actionRunBenchmark->setChecked(false);
                 QMessageBox::information(this, "Info", outInfo);
@@ -107,11 +135,36 @@ void AlgorithmBenchmarkWindow::onActionClearSpikesTriggered()
     for(auto* series : seriesArray)
     {
         QLineSeries* lineSeries = qobject_cast<QLineSeries*>(series);
+        if(!lineSeries)
+        {
+            continue;
+        }
 
-        QList<QPointF> oldPoints = lineSeries->points();
+        const QList<QPointF> oldPoints = getSeriesPoints(lineSeries);
 
         QList<QPointF> newPoints;
 
+        // statistics and inputs have to stay parallel to the points of the series
+        QList<BenchmarkStatistics>* statistics = nullptr;
+        QList<BenchmarkStatistics> newStatistics;
+
+        QList<ComplexityVariables>* inputs = nullptr;
+        QList<ComplexityVariables> newInputs;
+
+        auto it = seriesToResultData.find(lineSeries);
+        if(it != seriesToResultData.end())
+        {
+            if(it->mainSeriesStatistics.size() == oldPoints.size())
+            {
+                statistics = &it->mainSeriesStatistics;
+            }
+
+            if(it->mainSeriesInputs.size() == oldPoints.size())
+            {
+                inputs = &it->mainSeriesInputs;
+            }
+        }
+
         for(int i = 1; i < oldPoints.size() - 1; ++i)
         {
             const qreal a = oldPoints[i - 1].y();
@@ -123,18 +176,162 @@ void AlgorithmBenchmarkWindow::onActionClearSpikesTriggered()
             if(std::abs(b - threshold) < median)
             {
                 newPoints.append(oldPoints[i]);
+
+                if(statistics)
+                {
+                    newStatistics.append((*statistics)[i]);
+                }
+
+                if(inputs)
+                {
+                    newInputs.append((*inputs)[i]);
+                }
             }
         }
 
-        lineSeries->replace(newPoints);
+        setSeriesPoints(lineSeries, newPoints);
+
+        if(it != seriesToResultData.end())
+        {
+            it->mainSeries = newPoints;
+        }
+
+        if(statistics)
+        {
+            *statistics = newStatistics;
+        }
+
+        if(inputs)
+        {
+            *inputs = newInputs;
+        }
 
         chart->removeSeries(lineSeries);
         addSeries(lineSeries);
+
+        if(statistics)
+        {
+            removeConfidenceBand(lineSeries);
+            addConfidenceBand(lineSeries, *statistics);
+        }
     }
 
     chart->createDefaultAxes();
 }
 
+void AlgorithmBenchmarkWindow::onActionCompareTriggered()
+{
+    compareWithBaseline();
+}
+
+void AlgorithmBenchmarkWindow::onActionRunSuiteTriggered()
+{
+    if(jobQueue->isRunning())
+    {
+        QMessageBox::information(this, "Info", AlgorithmTexts::SuiteRunning);
+        return;
+    }
+
+    if(!algorithmToLiveSeries.isEmpty())
+    {
+        QMessageBox::information(this, "Info", AlgorithmTexts::BenchmarkRunning);
+        return;
+    }
+
+    bool ok = false;
+    const QString schedule = QInputDialog::getItem(this, "Run suite", "schedule", BenchmarkJobSchedules::All, 0, false, &ok);
+    if(!ok)
+    {
+        return;
+    }
+
+    // every algorithm runs with what is set in its properties panel
+    for(Algorithm* algorithm : std::as_const(algorithms["Graph Algorithms"]))
+    {
+        BenchmarkJob job;
+        job.algorithm = algorithm;
+        jobQueue->addJob(job);
+    }
+
+    // the first logical processor is left to the window
+    QList<int> workerCores = CacheControl::getAvailableCores();
+    if(schedule == BenchmarkJobSchedules::Parallel)
+    {
+        workerCores.removeFirst();
+    }
+    else
+    {
+        workerCores.clear();
+    }
+
+    QString outInfo;
+    if(!jobQueue->start(schedule, workerCores, outInfo))
+    {
+        jobQueue->stop();
+        QMessageBox::information(this, "Info", outInfo);
+        return;
+    }
+
+    actionRunBenchmark->setChecked(true);
+}
+
+void AlgorithmBenchmarkWindow::onActionResumeTriggered()
+{
+    if(jobQueue->isRunning())
+    {
+        QMessageBox::information(this, "Info", AlgorithmTexts::SuiteRunning);
+        return;
+    }
+
+    const QStringList algorithmNames = BenchmarkCheckpoint::findAlgorithmNames();
+    if(algorithmNames.isEmpty())
+    {
+        QMessageBox::information(this, "Info", AlgorithmTexts::NoCheckpoints);
+        return;
+    }
+
+    bool ok = false;
+    const QString algorithmName = QInputDialog::getItem(this, "Resume", "checkpoint", algorithmNames, 0, false, &ok);
+    if(!ok)
+    {
+        return;
+    }
+
+    Algorithm* algorithm = nullptr;
+    for(auto it = algorithms.constBegin(); it != algorithms.constEnd() && !algorithm; ++it)
+    {
+        for(Algorithm* categoryAlgorithm : it.value())
+        {
+            if(categoryAlgorithm->objectName() == algorithmName)
+            {
+                algorithm = categoryAlgorithm;
+                break;
+            }
+        }
+    }
+
+    if(!algorithm)
+    {
+        QMessageBox::information(this, "Info", AlgorithmTexts::NoAlgorithmForCheckpoint + algorithmName);
+        return;
+    }
+
+    if(algorithmToLiveSeries.contains(algorithm))
+    {
+        QMessageBox::information(this, "Info", AlgorithmTexts::BenchmarkRunning);
+        return;
+    }
+
+    QString outInfo;
+    if(!algorithm->prepareResume(outInfo))
+    {
+        QMessageBox::information(this, "Info", outInfo);
+        return;
+    }
+
+    QThreadPool::globalInstance()->start(algorithm);
+}
+
 #ifdef QT_DEBUG
 void AlgorithmBenchmarkWindow::onActionDebugRunTriggered()
 {
@@ -180,23 +377,50 @@ void AlgorithmBenchmarkWindow::onAlgorithmTreeItemClicked(const QModelIndex &ind
 void AlgorithmBenchmarkWindow::onAlgorithmStarted()
 {
     actionRunBenchmark->setChecked(true);
+
+    Algorithm* algorithm = qobject_cast<Algorithm*>(sender());
+    removeLiveSeries(algorithm);
+
+    QLineSeries* liveSeries = new QLineSeries(this);
+    liveSeries->setName(algorithm->objectName() + " (running)");
+
+    algorithmToLiveSeries[algorithm] = liveSeries;
+    algorithmToProgress[algorithm] = BenchmarkProgress();
+
+    addSeries(liveSeries);
+
+    partialResultsTimer->start();
+    updateProgressLabel();
 }
 
 void AlgorithmBenchmarkWindow::onAlgorithmFinished(const AlgorithmBenchmarkResult &resultData)
 {
-    actionRunBenchmark->setChecked(false);
+    actionRunBenchmark->setChecked(jobQueue->isRunning());
     actionRunBenchmark->setEnabled(true);
 
-    QLineSeries* newSeries = new QLineSeries(this);
-    newSeries->append(resultData.mainSeries);
-    newSeries->setName(sender()->objectName() + "_" + QString::number(chart->series().size()));
-    connect(newSeries, &QLineSeries::pressed, this, &AlgorithmBenchmarkWindow::onLineSeriesPressed);
+    removeLiveSeries(qobject_cast<Algorithm*>(sender()));
 
-    seriesToResultData[newSeries] = resultData;
+    QString name = sender()->objectName();
+    if(!resultData.variantName.isEmpty())
+    {
+        name.append(" (" + resultData.variantName + ")");
+    }
 
-    addSeries(newSeries);
+    addResultSeries(resultData, name + "_" + QString::number(chart->series().size()));
+}
 
-    chart->createDefaultAxes();
+void AlgorithmBenchmarkWindow::onSuiteJobFinished(const BenchmarkJob &job, const QString &info)
+{
+    const QString outcome = info.isEmpty() ? "saved to " + BenchmarkResultsStore::DefaultFilePath : info;
+    statusBar()->showMessage(job.getDescription() + " : " + outcome);
+}
+
+void AlgorithmBenchmarkWindow::onSuiteFinished(int jobsNum, int failedJobsNum)
+{
+    actionRunBenchmark->setChecked(false);
+    actionRunBenchmark->setEnabled(true);
+
+    statusBar()->showMessage("suite : " + QString::number(jobsNum) + " jobs, " + QString::number(failedJobsNum) + " failed");
 }
 
 void AlgorithmBenchmarkWindow::onLineSeriesPressed(const QPointF &point)
@@ -229,7 +453,7 @@ void AlgorithmBenchmarkWindow::onLineSeriesPressed(const QPointF &point)
             QLineSeries* newSeries = new QLineSeries(this);
             newSeries->setName(name);
 
-            newSeries->append(subSeries.points);
+            setSeriesPoints(newSeries, subSeries.points);
             newSeries->setColor(subSeries.color);
 
             addSeries(newSeries);
@@ -258,6 +482,16 @@ void AlgorithmBenchmarkWindow::onLineSeriesPressed(const QPointF &point)
 
         label->show();
 
+        const BenchmarkCallTree* callTree = BenchmarkCallTree::findNearest(seriesToResultData[lineSeries].callTrees, point.x());
+        if(callTree)
+        {
+            QTreeWidget* callTreeWidget = createCallTreeWidget(*callTree, chartView);
+            callTreeWidget->move(relativePos + QPoint(label->width(), 0));
+            callTreeWidget->show();
+
+            connect(label, &QObject::destroyed, callTreeWidget, &QObject::deleteLater);
+        }
+
         seriesToLabel[lineSeries] = label;
 
         penWidth = 6;
@@ -268,9 +502,40 @@ void AlgorithmBenchmarkWindow::onLineSeriesPressed(const QPointF &point)
     lineSeries->setPen(pen);
 }
 
+void AlgorithmBenchmarkWindow::onPartialResultsTimerTimeout()
+{
+    bool addedPoints = false;
+
+    for(auto it = algorithmToLiveSeries.begin(); it != algorithmToLiveSeries.end(); ++it)
+    {
+        Algorithm* algorithm = it.key();
+        QLineSeries* liveSeries = it.value();
+
+        const QList<BenchmarkPartialResults> partialResultsList = algorithm->takePartialResults();
+        for(const BenchmarkPartialResults& partialResults : partialResultsList)
+        {
+            appendSeriesPoints(liveSeries, partialResults.points);
+            algorithmToProgress[algorithm].addPartialResults(partialResults);
+
+            addedPoints = true;
+        }
+    }
+
+    if(addedPoints)
+    {
+        chart->createDefaultAxes();
+        updateProgressLabel();
+    }
+}
+
 void AlgorithmBenchmarkWindow::onPlotAreaChanged(const QRectF &plotArea)
 {
     clearSeriesSelection();
+
+    if(getDisplayedPointsNum() != displayedPointsNum)
+    {
+        refreshDisplayedSeries();
+    }
 }
 
 void AlgorithmBenchmarkWindow::onLegendMarkerClicked()
@@ -278,6 +543,12 @@ void AlgorithmBenchmarkWindow::onLegendMarkerClicked()
     QLegendMarker* marker = qobject_cast<QLegendMarker*>(sender());
     chart->removeSeries(marker->series());
 
+    QLineSeries* lineSeries = qobject_cast<QLineSeries*>(marker->series());
+    if(lineSeries)
+    {
+        removeConfidenceBand(lineSeries);
+    }
+
     auto seriesArray = chart->series();
     for(auto* series : seriesArray)
     {
@@ -309,6 +580,17 @@ void AlgorithmBenchmarkWindow::setupUi()
     QWidget* centralWidget = new QWidget(this);
     setCentralWidget(centralWidget);
 
+    progressLabel = new QLabel(this);
+    statusBar()->addPermanentWidget(progressLabel);
+
+    jobQueue = new BenchmarkJobQueue(this);
+    connect(jobQueue, &BenchmarkJobQueue::jobFinished, this, &AlgorithmBenchmarkWindow::onSuiteJobFinished);
+    connect(jobQueue, &BenchmarkJobQueue::allJobsFinished, this, &AlgorithmBenchmarkWindow::onSuiteFinished);
+
+    partialResultsTimer = new QTimer(this);
+    partialResultsTimer->setInterval(Algorithm::PartialResultsIntervalMs);
+    connect(partialResultsTimer, &QTimer::timeout, this, &AlgorithmBenchmarkWindow::onPartialResultsTimerTimeout);
+
     QFont titleFont;
     titleFont.setBold(true);
     titleFont.setPointSize(30);
@@ -394,6 +676,24 @@ void AlgorithmBenchmarkWindow::setupActionsAndToolBar()
     actionClearSpikes->setIcon(icon5);
     connect(actionClearSpikes, &QAction::triggered, this, &AlgorithmBenchmarkWindow::onActionClearSpikesTriggered);
 
+    actionCompare = new QAction(this);
+    QIcon icon7;
+    icon7.addFile(QString::fromUtf8(":/icons/compare.png"), QSize(), QIcon::Mode::Normal, QIcon::State::Off);
+    actionCompare->setIcon(icon7);
+    connect(actionCompare, &QAction::triggered, this, &AlgorithmBenchmarkWindow::onActionCompareTriggered);
+
+    actionRunSuite = new QAction(this);
+    QIcon icon8;
+    icon8.addFile(QString::fromUtf8(":/icons/run_suite.png"), QSize(), QIcon::Mode::Normal, QIcon::State::Off);
+    actionRunSuite->setIcon(icon8);
+    connect(actionRunSuite, &QAction::triggered, this, &AlgorithmBenchmarkWindow::onActionRunSuiteTriggered);
+
+    actionResume = new QAction(this);
+    QIcon icon9;
+    icon9.addFile(QString::fromUtf8(":/icons/resume.png"), QSize(), QIcon::Mode::Normal, QIcon::State::Off);
+    actionResume->setIcon(icon9);
+    connect(actionResume, &QAction::triggered, this, &AlgorithmBenchmarkWindow::onActionResumeTriggered);
+
 #ifdef QT_DEBUG
     debugRun = new QAction(this);
     QIcon icon6;
@@ -403,11 +703,14 @@ void AlgorithmBenchmarkWindow::setupActionsAndToolBar()
 #endif
 
 #if QT_CONFIG(tooltip)
-    actionSave->setToolTip("Save series to file");
-    actionLoad->setToolTip("Load series from file");
+    actionSave->setToolTip("Append the last series to the results store");
+    actionLoad->setToolTip("Load a series from the results store");
     actionClear->setToolTip("Clear all series");
     actionRunBenchmark->setToolTip("Pause/Run benchmark");
     actionClearSpikes->setToolTip("Clear spikes");
+    actionCompare->setToolTip("Compare the last series with a stored baseline");
+    actionRunSuite->setToolTip("Run every graph algorithm one after another or in parallel on pinned workers and save every result");
+    actionResume->setToolTip("Continue a paused or interrupted sweep from its checkpoint");
 
 #ifdef QT_DEBUG
     debugRun->setToolTip("Debug run: select algorithm and view result in console");
@@ -427,6 +730,9 @@ void AlgorithmBenchmarkWindow::setupActionsAndToolBar()
     toolBar->addSeparator();
     toolBar->addAction(actionRunBenchmark);
     toolBar->addAction(actionClearSpikes);
+    toolBar->addAction(actionCompare);
+    toolBar->addAction(actionRunSuite);
+    toolBar->addAction(actionResume);
 
 #ifdef QT_DEBUG
     toolBar->addAction(debugRun);
@@ -458,6 +764,7 @@ void AlgorithmBenchmarkWindow::registerAlgorithms()
     algorithmsList.append(new EagerDijkstraAlgorithm);
     algorithmsList.append(new BellmanFordAlgorithm);
     algorithmsList.append(new FloydWarshallAlgorithm);
+    algorithmsList.append(new ParallelFloydWarshallAlgorithm);
 
     algorithmsList.append(new SCCsAlgorithm);
 
@@ -474,15 +781,43 @@ void AlgorithmBenchmarkWindow::registerAlgorithms()
     algorithmsList.append(new MaxNetworkFlowCapacityScalingAlgorithm);
     algorithmsList.append(new MaxNetworkFlowDinicAlgorithm);
 
-    for(auto* algorithm : algorithmsList)
+    QList<Algorithm*>& buildersList = algorithms["Graph Builders"];
+
+    buildersList.append(new GraphConstructionBenchmark(new GeneralGraphBuilder));
+    buildersList.append(new GraphConstructionBenchmark(new GridGraphBuilder));
+    buildersList.append(new GraphConstructionBenchmark(new TreeGraphBuilder));
+    buildersList.append(new GraphConstructionBenchmark(new GeneralResidualGraphBuilder));
+    buildersList.append(new GraphConstructionBenchmark(new GridResidualGraphBuilder));
+    buildersList.append(new GraphConstructionBenchmark(new TreeResidualGraphBuilder));
+
+    QList<Algorithm*>& microbenchmarksList = algorithms["Microbenchmarks"];
+
+    microbenchmarksList.append(new AddEdgeMicrobenchmark);
+    microbenchmarksList.append(new HasEdgeToMicrobenchmark);
+    microbenchmarksList.append(new GetEdgeWeightMicrobenchmark);
+    microbenchmarksList.append(new ForEachNeighbourMicrobenchmark);
+    microbenchmarksList.append(new ForEachEdgeMicrobenchmark);
+    microbenchmarksList.append(new GetNeighbourAtMicrobenchmark);
+
+    microbenchmarksList.append(new PriorityQueueMicrobenchmark);
+    microbenchmarksList.append(new IndexedPriorityQueueMicrobenchmark);
+    microbenchmarksList.append(new DenseIndexedPriorityQueueMicrobenchmark);
+    microbenchmarksList.append(new EdgeListMicrobenchmark);
+
+    for(auto categoryIt = algorithms.constBegin(); categoryIt != algorithms.constEnd(); ++categoryIt)
     {
-        connect(algorithm, &Algorithm::started, this, &AlgorithmBenchmarkWindow::onAlgorithmStarted);
-        connect(algorithm, &Algorithm::finished, this, &AlgorithmBenchmarkWindow::onAlgorithmFinished);
+        for(auto* algorithm : categoryIt.value())
+        {
+            connect(algorithm, &Algorithm::started, this, &AlgorithmBenchmarkWindow::onAlgorithmStarted);
+            connect(algorithm, &Algorithm::finished, this, &AlgorithmBenchmarkWindow::onAlgorithmFinished);
+        }
     }
 }
 
 void AlgorithmBenchmarkWindow::endBenchmarkRun(bool deleteAllAlgorithms)
 {
+    jobQueue->stop();
+
     for(auto it = algorithms.constBegin(); it != algorithms.constEnd(); ++it)
     {
         const QList<Algorithm*>& algorithmsList = it.value();
@@ -510,74 +845,134 @@ Algorithm *AlgorithmBenchmarkWindow::getSelectedAlgorithm() const
     return modelIndex.isValid() ? qvariant_cast<Algorithm*>(modelIndex.data(Qt::UserRole)) : nullptr;
 }
 
-void AlgorithmBenchmarkWindow::saveSeriesToFile()
+void AlgorithmBenchmarkWindow::saveSeriesToStore()
 {
-    auto series = chart->series();
+    QLineSeries* lastSeries = getLastResultSeries();
+    if(!lastSeries)
+    {
+        return;
+    }
+
+    AlgorithmBenchmarkResult& resultData = seriesToResultData[lastSeries];
+
+    QString outInfo;
+    if(!BenchmarkResultsStore().appendRun(resultData, outInfo))
+    {
+        QMessageBox::warning(this, "Warning", outInfo);
+    }
+}
 
-    if(series.empty())
+void AlgorithmBenchmarkWindow::loadSeriesFromStore()
+{
+    AlgorithmBenchmarkResult resultData;
+    if(!selectStoredRun("Load series", resultData))
     {
         return;
     }
 
-    QFile saveFile("benchmark series.txt");
-    if(!saveFile.open(QIODevice::WriteOnly))
+    const QString& info = resultData.toolTipInfo;
+    addResultSeries(resultData, info.left(info.indexOf('\n')) + "_" + QString::number(chart->series().size() + 1));
+}
+
+void AlgorithmBenchmarkWindow::compareWithBaseline()
+{
+    QLineSeries* candidateSeries = getLastResultSeries();
+    if(!candidateSeries)
+    {
+        QMessageBox::information(this, "Info", AlgorithmTexts::NoSeriesToCompare);
+        return;
+    }
+
+    AlgorithmBenchmarkResult baseline;
+    if(!selectStoredRun("Select baseline", baseline))
     {
         return;
     }
 
-    QLineSeries* lastSeries = qobject_cast<QLineSeries*>(series[series.size() - 1]);
+    AlgorithmBenchmarkResult& candidate = seriesToResultData[candidateSeries];
+    const QString candidateName = candidateSeries->name();
 
-    QJsonObject infoAsJsonObject;
-    infoAsJsonObject["info"] = seriesToResultData[lastSeries].toolTipInfo;
+    QLineSeries* baselineSeries = addResultSeries(baseline, "baseline " + baseline.runInfo.algorithmName + " (" + baseline.runInfo.gitRevision + ")");
 
-    QJsonArray resultArray;
-    resultArray.append(infoAsJsonObject);
+    QPen baselinePen = baselineSeries->pen();
+    baselinePen.setStyle(Qt::DashLine);
+    baselineSeries->setPen(baselinePen);
 
-    const QList<QPointF> result = lastSeries->points();
-    for(const auto& point : result)
+    const BenchmarkComparison comparison = BenchmarkComparison::compare(baseline, candidate);
+
+    const QList<QPointF> regressionPoints = comparison.getRegressionPoints();
+    if(!regressionPoints.isEmpty())
     {
-        QJsonObject pointAsJsonObject;
-        pointAsJsonObject["x"] = point.x();
-        pointAsJsonObject["y"] = point.y();
-        resultArray.append(pointAsJsonObject);
+        QScatterSeries* regressionsSeries = new QScatterSeries(this);
+        regressionsSeries->setName(candidateName + " regressions");
+        regressionsSeries->setColor(Qt::red);
+        regressionsSeries->setMarkerSize(12.0);
+        setSeriesPoints(regressionsSeries, regressionPoints);
+
+        addSeries(regressionsSeries);
+        chart->createDefaultAxes();
     }
 
-    const QJsonDocument jsonDoc(resultArray);
+    QString comparisonInfo = "baseline : " + baseline.runInfo.getDescription();
+    comparisonInfo.append("\n");
+    comparison.appendInfo(comparisonInfo);
+
+    candidate.toolTipInfo.append(comparisonInfo);
 
-    saveFile.write(jsonDoc.toJson());
-    saveFile.close();
+    QMessageBox::information(this, candidateName + " vs baseline", comparisonInfo);
 }
 
-void AlgorithmBenchmarkWindow::loadSeriesFromFile()
+bool AlgorithmBenchmarkWindow::selectStoredRun(const QString &title, AlgorithmBenchmarkResult &outRun)
 {
-    QFile loadFile("benchmark series.txt");
-    if(!loadFile.open(QIODevice::ReadOnly))
+    QList<AlgorithmBenchmarkResult> storedRuns;
+
+    QString outInfo;
+    if(!BenchmarkResultsStore().loadRuns(storedRuns, outInfo))
     {
-        return;
+        QMessageBox::information(this, "Info", outInfo);
+        return false;
     }
 
-    const QByteArray jsonData = loadFile.readAll();
-    loadFile.close();
-
-    QLineSeries* newSeries = new QLineSeries;
-    connect(newSeries, &QLineSeries::pressed, this, &AlgorithmBenchmarkWindow::onLineSeriesPressed);
-
-    const QJsonDocument jsonDoc = QJsonDocument::fromJson(jsonData);
-    const QJsonArray resultJsonArray = jsonDoc.array();
+    if(storedRuns.isEmpty())
+    {
+        return false;
+    }
 
-    const QString info = resultJsonArray[0].toObject()["info"].toString();
-    seriesToResultData[newSeries].toolTipInfo = info;
+    // newest runs first, numbered so runs with the same description stay distinct
+    QStringList descriptions;
+    descriptions.reserve(storedRuns.size());
 
-    newSeries->setName(info.left(info.indexOf('\n')) + "_" + QString::number(chart->series().size() + 1));
+    for(auto it = storedRuns.crbegin(); it != storedRuns.crend(); ++it)
+    {
+        descriptions.append(QString::number(descriptions.size() + 1) + ". " + it->runInfo.getDescription());
+    }
 
-    for(int i = 1; i < resultJsonArray.size(); ++i)
+    bool ok = false;
+    const QString selectedDescription = QInputDialog::getItem(this, title, "Stored runs", descriptions, 0, false, &ok);
+    if(!ok)
     {
-        const QJsonObject jsonObj = resultJsonArray[i].toObject();
-        newSeries->append(QPointF(jsonObj["x"].toDouble(), jsonObj["y"].toDouble()));
+        return false;
     }
 
+    outRun = storedRuns[storedRuns.size() - 1 - descriptions.indexOf(selectedDescription)];
+    return true;
+}
+
+QLineSeries *AlgorithmBenchmarkWindow::addResultSeries(const AlgorithmBenchmarkResult &resultData, const QString &name)
+{
+    QLineSeries* newSeries = new QLineSeries(this);
+    setSeriesPoints(newSeries, resultData.mainSeries);
+    newSeries->setName(name);
+    connect(newSeries, &QLineSeries::pressed, this, &AlgorithmBenchmarkWindow::onLineSeriesPressed);
+
+    seriesToResultData[newSeries] = resultData;
+
     addSeries(newSeries);
+    addConfidenceBand(newSeries, resultData.mainSeriesStatistics);
+
     chart->createDefaultAxes();
+
+    return newSeries;
 }
 
 void AlgorithmBenchmarkWindow::clearSeriesSelection()
@@ -603,6 +998,219 @@ void AlgorithmBenchmarkWindow::addSeries(QAbstractSeries* series)
 
     QLegendMarker* marker = markers[0];
 
+    // bands are removed together with their main series
+    if(qobject_cast<QAreaSeries*>(series))
+    {
+        marker->setVisible(false);
+        return;
+    }
+
     connect(marker, &QLegendMarker::clicked, this, &AlgorithmBenchmarkWindow::onLegendMarkerClicked);
     connect(marker, &QLegendMarker::hovered, this, &AlgorithmBenchmarkWindow::onLegendMarkerHovered);
 }
+
+void AlgorithmBenchmarkWindow::addConfidenceBand(QLineSeries *mainSeries, const QList<BenchmarkStatistics> &statistics)
+{
+    const QList<QPointF> points = getSeriesPoints(mainSeries);
+    if(statistics.size() != points.size())
+    {
+        return;
+    }
+
+    const bool hasSpread = std::any_of(statistics.begin(), statistics.end(), [](const BenchmarkStatistics& pointStatistics)
+    {
+        return pointStatistics.p90 > pointStatistics.min;
+    });
+
+    if(!hasSpread)
+    {
+        return;
+    }
+
+    QLineSeries* lowerSeries = new QLineSeries;
+    QLineSeries* upperSeries = new QLineSeries;
+
+    QList<QPointF> lowerPoints;
+    QList<QPointF> upperPoints;
+
+    lowerPoints.reserve(points.size());
+    upperPoints.reserve(points.size());
+
+    for(int i = 0; i < points.size(); ++i)
+    {
+        lowerPoints.append(QPointF(points[i].x(), statistics[i].min));
+        upperPoints.append(QPointF(points[i].x(), statistics[i].p90));
+    }
+
+    setSeriesPoints(lowerSeries, lowerPoints);
+    setSeriesPoints(upperSeries, upperPoints);
+
+    QAreaSeries* band = new QAreaSeries(upperSeries, lowerSeries);
+    band->setName(mainSeries->name() + " (min - p90)");
+
+    upperSeries->setParent(band);
+    lowerSeries->setParent(band);
+
+    QColor bandColor = mainSeries->color();
+    bandColor.setAlpha(60);
+    band->setColor(bandColor);
+    band->setBorderColor(Qt::transparent);
+
+    seriesToBand[mainSeries] = band;
+
+    addSeries(band);
+}
+
+void AlgorithmBenchmarkWindow::removeConfidenceBand(QLineSeries *mainSeries)
+{
+    QAreaSeries* band = seriesToBand.take(mainSeries);
+    if(band)
+    {
+        chart->removeSeries(band);
+        band->deleteLater();
+    }
+}
+
+void AlgorithmBenchmarkWindow::setSeriesPoints(QXYSeries *series, const QList<QPointF> &points)
+{
+    if(!seriesToFullPoints.contains(series))
+    {
+        connect(series, &QObject::destroyed, this, [this, series]()
+        {
+            seriesToFullPoints.remove(series);
+        });
+    }
+
+    seriesToFullPoints[series] = points;
+    series->replace(SeriesDownsamplingUtils::largestTriangleThreeBuckets(points, getDisplayedPointsNum()));
+}
+
+void AlgorithmBenchmarkWindow::appendSeriesPoints(QXYSeries *series, const QList<QPointF> &points)
+{
+    auto it = seriesToFullPoints.find(series);
+    if(it == seriesToFullPoints.end())
+    {
+        setSeriesPoints(series, points);
+        return;
+    }
+
+    it->append(points);
+
+    // below the limit the series can grow incrementally, above it the decimation has to be redone
+    if(it->size() <= getDisplayedPointsNum())
+    {
+        series->append(points);
+    }
+    else
+    {
+        series->replace(SeriesDownsamplingUtils::largestTriangleThreeBuckets(*it, getDisplayedPointsNum()));
+    }
+}
+
+QList<QPointF> AlgorithmBenchmarkWindow::getSeriesPoints(QXYSeries *series) const
+{
+    auto it = seriesToFullPoints.constFind(series);
+    return it != seriesToFullPoints.constEnd() ? it.value() : series->points();
+}
+
+int AlgorithmBenchmarkWindow::getDisplayedPointsNum() const
+{
+    constexpr int minDisplayedPointsNum = 200;
+    return std::max(minDisplayedPointsNum, 2 * qRound(chart->plotArea().width()));
+}
+
+void AlgorithmBenchmarkWindow::refreshDisplayedSeries()
+{
+    displayedPointsNum = getDisplayedPointsNum();
+
+    for(auto it = seriesToFullPoints.constBegin(); it != seriesToFullPoints.constEnd(); ++it)
+    {
+        it.key()->replace(SeriesDownsamplingUtils::largestTriangleThreeBuckets(it.value(), displayedPointsNum));
+    }
+}
+
+QTreeWidget *AlgorithmBenchmarkWindow::createCallTreeWidget(const BenchmarkCallTree &callTree, QWidget *parent) const
+{
+    QTreeWidget* callTreeWidget = new QTreeWidget(parent);
+    callTreeWidget->setStyleSheet("border: 1px solid black; background-color: white;");
+    callTreeWidget->setHeaderLabels({"timers at x = " + QString::number(callTree.x, 'g', 6), "total", "self", "calls"});
+
+    // parents come before their children, so every parent item exists when its children are added
+    QList<QTreeWidgetItem*> items;
+    items.reserve(callTree.nodes.size());
+
+    for(const BenchmarkCallTreeNode& node : callTree.nodes)
+    {
+        QTreeWidgetItem* item = node.parent >= 0 ? new QTreeWidgetItem(items[node.parent]) : new QTreeWidgetItem(callTreeWidget);
+        item->setText(0, node.name);
+        item->setText(1, QString::number(node.totalCycles, 'f', 0));
+        item->setText(2, QString::number(node.selfCycles, 'f', 0));
+        item->setText(3, QString::number(node.callsNum, 'g', 6));
+
+        for(int column = 1; column < 4; ++column)
+        {
+            item->setTextAlignment(column, Qt::AlignRight);
+        }
+
+        items.append(item);
+    }
+
+    callTreeWidget->expandAll();
+    for(int column = 0; column < 4; ++column)
+    {
+        callTreeWidget->resizeColumnToContents(column);
+    }
+
+    callTreeWidget->resize(callTreeWidget->header()->length() + 4, 200);
+
+    return callTreeWidget;
+}
+
+void AlgorithmBenchmarkWindow::removeLiveSeries(Algorithm *algorithm)
+{
+    QLineSeries* liveSeries = algorithmToLiveSeries.take(algorithm);
+    algorithmToProgress.remove(algorithm);
+
+    if(liveSeries)
+    {
+        // the legend marker may already have removed it from the chart
+        if(chart->series().contains(liveSeries))
+        {
+            chart->removeSeries(liveSeries);
+        }
+        liveSeries->deleteLater();
+    }
+
+    if(algorithmToLiveSeries.isEmpty())
+    {
+        partialResultsTimer->stop();
+    }
+
+    updateProgressLabel();
+}
+
+void AlgorithmBenchmarkWindow::updateProgressLabel()
+{
+    QStringList progressTexts;
+    for(auto it = algorithmToProgress.constBegin(); it != algorithmToProgress.constEnd(); ++it)
+    {
+        progressTexts.append(it.key()->objectName() + " : " + it.value().getText());
+    }
+
+    progressLabel->setText(progressTexts.join("   "));
+}
+
+QLineSeries *AlgorithmBenchmarkWindow::getLastResultSeries() const
+{
+    const auto series = chart->series();
+    for(auto it = series.crbegin(); it != series.crend(); ++it)
+    {
+        QLineSeries* lineSeries = qobject_cast<QLineSeries*>(*it);
+        if(lineSeries && seriesToResultData.contains(lineSeries))
+        {
+            return lineSeries;
+        }
+    }
+
+    return nullptr;
+}
@@ -1,6 +1,8 @@
 #ifndef ALGORITHM_BENCHMARK_WINDOW_H
 #define ALGORITHM_BENCHMARK_WINDOW_H
 
+#include "../core/benchmark_partial_results.h"
+
 #include <QCheckBox>
 #include <QHBoxLayout>
 #include <QMainWindow>
@@ -8,14 +10,21 @@
 #include <QTimer>
 
 class QAbstractSeries;
+class QAreaSeries;
 class QLabel;
 class QLineSeries;
+class QXYSeries;
 class QChart;
 class QChartView;
 class QVBoxLayout;
 class QTreeView;
+class QTreeWidget;
 class Algorithm;
+class BenchmarkJobQueue;
 struct AlgorithmBenchmarkResult;
+struct BenchmarkJob;
+struct BenchmarkCallTree;
+struct BenchmarkStatistics;
 
 class AlgorithmBenchmarkWindow : public QMainWindow
 {
@@ -34,6 +43,9 @@ private slots:
     void onActionClearTriggered();
     void onActionRunBenchmarkTriggered(bool isOn);
     void onActionClearSpikesTriggered();
+    void onActionCompareTriggered();
+    void onActionRunSuiteTriggered();
+    void onActionResumeTriggered();
 
 #ifdef QT_DEBUG
     void onActionDebugRunTriggered();
@@ -44,8 +56,14 @@ private slots:
     void onAlgorithmStarted();
     void onAlgorithmFinished(const AlgorithmBenchmarkResult &resultData);
 
+    void onSuiteJobFinished(const BenchmarkJob& job, const QString& info);
+    void onSuiteFinished(int jobsNum, int failedJobsNum);
+
     void onLineSeriesPressed(const QPointF& point);
 
+    // appends streamed points of running benchmarks to their live series
+    void onPartialResultsTimerTimeout();
+
     void onPlotAreaChanged(const QRectF &plotArea);
 
     void onLegendMarkerClicked();
@@ -61,12 +79,40 @@ private:
 
     Algorithm* getSelectedAlgorithm() const;
 
-    void saveSeriesToFile();
-    void loadSeriesFromFile();
+    // appends the last result series to the results store
+    void saveSeriesToStore();
+    void loadSeriesFromStore();
+
+    // overlays a stored baseline on the last result series and flags significant regressions
+    void compareWithBaseline();
+
+    bool selectStoredRun(const QString& title, AlgorithmBenchmarkResult& outRun);
+    QLineSeries* addResultSeries(const AlgorithmBenchmarkResult& resultData, const QString& name);
 
     void clearSeriesSelection();
     void addSeries(QAbstractSeries* series);
 
+    // band between min and p90 of repeated measurements, drawn below the main series
+    void addConfidenceBand(QLineSeries* mainSeries, const QList<BenchmarkStatistics>& statistics);
+    void removeConfidenceBand(QLineSeries* mainSeries);
+
+    QLineSeries* getLastResultSeries() const;
+
+    // displayed series only get a decimated copy of their points, the full points are kept here
+    void setSeriesPoints(QXYSeries* series, const QList<QPointF>& points);
+    void appendSeriesPoints(QXYSeries* series, const QList<QPointF>& points);
+    QList<QPointF> getSeriesPoints(QXYSeries* series) const;
+
+    // about two points per pixel of the plot area
+    int getDisplayedPointsNum() const;
+    void refreshDisplayedSeries();
+
+    // drill-down of the nested timers of one point, shown next to the series info
+    QTreeWidget* createCallTreeWidget(const BenchmarkCallTree& callTree, QWidget* parent) const;
+
+    void removeLiveSeries(Algorithm* algorithm);
+    void updateProgressLabel();
+
     QTreeView* algorithmsTreeView;
 
     QChart *chart;
@@ -76,6 +122,20 @@ private:
 
     QHash<QLineSeries*, AlgorithmBenchmarkResult> seriesToResultData;
     QHash<QLineSeries*, QLabel*> seriesToLabel;
+    QHash<QLineSeries*, QAreaSeries*> seriesToBand;
+
+    QHash<QXYSeries*, QList<QPointF>> seriesToFullPoints;
+    int displayedPointsNum;
+
+    // series growing while a benchmark runs, replaced by the full result when it finishes
+    QHash<Algorithm*, QLineSeries*> algorithmToLiveSeries;
+    QHash<Algorithm*, BenchmarkProgress> algorithmToProgress;
+
+    QTimer* partialResultsTimer;
+    QLabel* progressLabel;
+
+    // every graph algorithm as one job, results go straight to the results store
+    BenchmarkJobQueue* jobQueue;
 
     // Actions
     QAction* actionSave;
@@ -83,6 +143,9 @@ private:
     QAction* actionClear;
     QAction* actionRunBenchmark;
     QAction* actionClearSpikes;
+    QAction* actionCompare;
+    QAction* actionRunSuite;
+    QAction* actionResume;
 
 #ifdef QT_DEBUG
     QAction* debugRun;